@@ -1247,6 +1247,23 @@ static void CG_ResetMaxSpeed_f(void)
 	resetmaxspeed = qtrue;
 }
 
+/**
+ * @brief Prints how many Pmoves the optimized prediction saved, "predictstats reset" clears the counters
+ */
+static void CG_PredictStats_f(void)
+{
+	int total = cg.numPredictedCmds + cg.numPlayedBackCmds;
+
+	CG_Printf("Prediction: %d commands, %d Pmoves run, %d played back (%.1f%% saved)\n", total, cg.numPredictedCmds, cg.numPlayedBackCmds,
+	          total ? 100.0 * cg.numPlayedBackCmds / total : 0.0);
+
+	if (trap_Argc() > 1 && !Q_stricmp(CG_Argv(1), "reset"))
+	{
+		cg.numPredictedCmds  = 0;
+		cg.numPlayedBackCmds = 0;
+	}
+}
+
 /**
  * @brief ETPro style enemy spawntimer
  */
@@ -2266,6 +2283,7 @@ static consoleCommand_t commands[] =
 	{ "oinfo",               CG_PrintObjectiveInfo_f   },
 	{ "resetmaxspeed",       CG_ResetMaxSpeed_f        },
 	{ "listspawnpt",         CG_ListSpawnPoints_f      },
+	{ "predictstats",        CG_PredictStats_f         },
 
 	{ "loc",                 CG_Location_f             },
 	{ "camera",              CG_Camera_f               },
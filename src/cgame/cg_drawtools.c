@@ -734,13 +734,27 @@ const char *CG_TranslateString(const char *string)
 	static char buffer[TRANSLATION_BUFFERS][MAX_PRINT_MSG];
 	static int  buffOffset = 0;
 	char        *buf;
+	const char  *cached;
+	int         generation = cg.translationGeneration;
 
 	// some code expects this to return a copy always, even
 	// if none is needed for translation, so always supply another buffer
 	buf = buffer[buffOffset++ % TRANSLATION_BUFFERS];
 
+	// only ask the engine once per string and language
+	if (generation >= 0 && (cached = Translation_Find(string, generation)) != NULL)
+	{
+		Q_strncpyz(buf, cached, MAX_PRINT_MSG);
+		return buf;
+	}
+
 	trap_TranslateString(string, buf);
 
+	if (generation >= 0)
+	{
+		Translation_Add(string, buf, generation);
+	}
+
 	return buf;
 }
 
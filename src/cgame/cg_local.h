@@ -1477,6 +1477,8 @@ typedef struct
 	int backupStateTail;
 	int lastPredictedCommand;
 	int lastPhysicsTime;
+	int numPredictedCmds;       ///< commands run through Pmove by the prediction
+	int numPlayedBackCmds;      ///< commands taken from backupStates instead of running Pmove
 
 	qboolean skyboxEnabled;
 	vec3_t skyboxViewOrg;
@@ -1562,6 +1564,8 @@ typedef struct
 	char bannerPrint[1024];
 
 	int lastKeyCatcher;
+
+	int translationGeneration;          ///< language generation of the engine, read once a frame for CG_TranslateString
 } cg_t;
 
 #define MAX_LOCKER_DEBRIS 5
@@ -3456,6 +3460,7 @@ int trap_RealTime(qtime_t *qtime);
 // console variable interaction
 void trap_Cvar_Register(vmCvar_t *vmCvar, const char *varName, const char *defaultValue, int flags);
 void trap_Cvar_Update(vmCvar_t *vmCvar);
+void CG_InitExtensionTraps(void);
 void trap_Cvar_Set(const char *varName, const char *value);
 void trap_Cvar_VariableStringBuffer(const char *varName, char *buffer, int bufsize);
 void trap_Cvar_LatchedVariableStringBuffer(const char *varName, char *buffer, int bufsize);
@@ -3662,6 +3667,7 @@ void trap_Key_SetBinding(int keynum, const char *binding);
 void trap_Key_KeynumToStringBuf(int keynum, char *buf, int buflen);
 
 void trap_TranslateString(const char *string, char *buf);       //  localization
+int trap_TranslationGeneration(void);
 
 int trap_CIN_PlayCinematic(const char *arg0, int xpos, int ypos, int width, int height, int bits);
 e_status trap_CIN_StopCinematic(int handle);
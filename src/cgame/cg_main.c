@@ -701,6 +701,7 @@ static cvarTable_t cvarTable[] =
 
 static const unsigned int cvarTableSize = sizeof(cvarTable) / sizeof(cvarTable[0]);
 static qboolean           cvarsLoaded   = qfalse;
+static bgCvarChanges_t    cvarChanges;
 void CG_setClientFlags(void);
 
 /**
@@ -723,11 +724,15 @@ void CG_RegisterCvars(void)
 		trap_Cvar_Register(&cg_customFont2, "cg_customFont2", "", CVAR_ARCHIVE);
 	}
 
+	Com_Memset(&cvarChanges, 0, sizeof(cvarChanges));
+
 	for (i = 0, cv = cvarTable ; i < cvarTableSize ; i++, cv++)
 	{
 		trap_Cvar_Register(cv->vmCvar, cv->cvarName, cv->defaultString, cv->cvarFlags);
 		if (cv->vmCvar != NULL)
 		{
+			BG_CvarChangesRegister(&cvarChanges, i, cv->vmCvar);
+
 			// force the update to range check this cvar on first run
 			if (cv->vmCvar == &cg_errorDecay)
 			{
@@ -757,17 +762,23 @@ void CG_RegisterCvars(void)
  */
 void CG_UpdateCvars(void)
 {
-	unsigned int i;
-	qboolean     fSetFlags = qfalse;
-	cvarTable_t  *cv;
+	int         i, numChanges;
+	int         changes[ARRAY_LEN(cvarTable)];
+	qboolean    fSetFlags = qfalse;
+	cvarTable_t *cv;
 
 	if (!cvarsLoaded)
 	{
 		return;
 	}
 
-	for (i = 0, cv = cvarTable ; i < cvarTableSize ; i++, cv++)
+	// only visit the cvars which changed, if the engine tells us
+	numChanges = BG_CvarChangesGet(&cvarChanges, changes, cvarTableSize);
+
+	for (i = 0 ; i < numChanges ; i++)
 	{
+		cv = &cvarTable[changes[i]];
+
 		if (cv->vmCvar)
 		{
 			trap_Cvar_Update(cv->vmCvar);
@@ -2779,6 +2790,10 @@ void CG_Init(int serverMessageNum, int serverCommandSequence, int clientNum, qbo
 
 	MOD_CHECK_ETLEGACY(etLegacyClient, clientVersion, cg.etLegacyClient);
 
+	CG_InitExtensionTraps();
+
+	cg.translationGeneration = trap_TranslationGeneration();
+
 	// get the rendering configuration from the client system
 	trap_GetGlconfig(&cgs.glconfig);
 	cgs.screenXScale = cgs.glconfig.vidWidth / 640.0f;
@@ -755,6 +755,9 @@ void CG_mvDraw(cg_window_t *sw)
 	refdef.time = cg.time;
 	trap_SetClientLerpOrigin(refdef.vieworg[0], refdef.vieworg[1], refdef.vieworg[2]);
 
+	// particles, flames and trails of this window, the main view adds its own in CG_DrawActive
+	CG_PB_RenderPolyBuffers();
+
 	trap_R_RenderScene(&refdef);
 
 	cg.refdef_current = &cg.refdef;
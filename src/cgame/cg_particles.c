@@ -239,6 +239,153 @@ void CG_InitParticles(void)
 	CG_ParsePatriclesConfig();
 }
 
+#define MAX_PARTICLE_POLYS          4096    // polys staged per CG_AddParticles call, more go to the scene one by one
+#define MAX_PARTICLE_POLY_SHADERS   64      // shaders whose polys are batched per CG_AddParticles call
+
+/**
+ * @struct particlePoly_s
+ * @brief A particle polygon waiting for CG_FlushParticlePolys
+ */
+typedef struct particlePoly_s
+{
+	qhandle_t shader;
+	int numVerts;
+	polyVert_t verts[4];
+} particlePoly_t;
+
+static particlePoly_t particlePolys[MAX_PARTICLE_POLYS];
+static int            numParticlePolys;
+
+/**
+ * @brief Stages a particle polygon, so all particles sharing a shader can reach
+ * the renderer as one surface instead of one poly each
+ * @param[in] shader
+ * @param[in] numVerts
+ * @param[in] verts
+ */
+static void CG_AddParticlePoly(qhandle_t shader, int numVerts, polyVert_t *verts)
+{
+	if (numParticlePolys == MAX_PARTICLE_POLYS)
+	{
+		trap_R_AddPolyToScene(shader, numVerts, verts);
+		return;
+	}
+
+	particlePolys[numParticlePolys].shader   = shader;
+	particlePolys[numParticlePolys].numVerts = numVerts;
+	Com_Memcpy(particlePolys[numParticlePolys].verts, verts, numVerts * sizeof(*verts));
+	numParticlePolys++;
+}
+
+/**
+ * @brief Appends a particle polygon to the poly buffer of its shader
+ * @param[in] poly
+ */
+static void CG_AddParticlePolyToBuffer(particlePoly_t *poly)
+{
+	polyBuffer_t *pPolyBuffer = CG_PB_FindFreePolyBuffer(poly->shader, poly->numVerts, (poly->numVerts - 2) * 3);
+	int          i, base;
+
+	if (!pPolyBuffer)
+	{
+		trap_R_AddPolyToScene(poly->shader, poly->numVerts, poly->verts);
+		return;
+	}
+
+	base = pPolyBuffer->numVerts;
+
+	for (i = 0; i < poly->numVerts; i++)
+	{
+		VectorCopy(poly->verts[i].xyz, pPolyBuffer->xyz[base + i]);
+		pPolyBuffer->st[base + i][0] = poly->verts[i].st[0];
+		pPolyBuffer->st[base + i][1] = poly->verts[i].st[1];
+		Com_Memcpy(pPolyBuffer->color[base + i], poly->verts[i].modulate, sizeof(pPolyBuffer->color[0]));
+	}
+
+	// triangle fan, like the renderer does for a single poly
+	for (i = 2; i < poly->numVerts; i++)
+	{
+		pPolyBuffer->indicies[pPolyBuffer->numIndicies++] = (unsigned int)base;
+		pPolyBuffer->indicies[pPolyBuffer->numIndicies++] = (unsigned int)(base + i - 1);
+		pPolyBuffer->indicies[pPolyBuffer->numIndicies++] = (unsigned int)(base + i);
+	}
+
+	pPolyBuffer->numVerts += poly->numVerts;
+}
+
+/**
+ * @brief Hands the staged particle polygons to the renderer
+ *
+ * The renderer picks a single fog volume for a poly buffer from the bounds of
+ * all of its polys. Shaders whose particles reach into a fog brush therefore
+ * keep adding one poly each, so only the particles in the fog get fogged.
+ */
+static void CG_FlushParticlePolys(void)
+{
+	qhandle_t      shaders[MAX_PARTICLE_POLY_SHADERS];
+	vec3_t         mins[MAX_PARTICLE_POLY_SHADERS], maxs[MAX_PARTICLE_POLY_SHADERS];
+	qboolean       batch[MAX_PARTICLE_POLY_SHADERS];
+	vec3_t         center, halfMins, halfMaxs;
+	trace_t        tr;
+	particlePoly_t *poly;
+	int            numShaders = 0, i, j, k;
+
+	// bounds of the particles of each shader
+	for (i = 0, poly = particlePolys; i < numParticlePolys; i++, poly++)
+	{
+		for (j = 0; j < numShaders && shaders[j] != poly->shader; j++)
+		{
+		}
+
+		if (j == numShaders)
+		{
+			if (numShaders == MAX_PARTICLE_POLY_SHADERS)
+			{
+				continue;
+			}
+			shaders[numShaders] = poly->shader;
+			ClearBounds(mins[numShaders], maxs[numShaders]);
+			numShaders++;
+		}
+
+		for (k = 0; k < poly->numVerts; k++)
+		{
+			AddPointToBounds(poly->verts[k].xyz, mins[j], maxs[j]);
+		}
+	}
+
+	for (j = 0; j < numShaders; j++)
+	{
+		for (k = 0; k < 3; k++)
+		{
+			center[k]   = (mins[j][k] + maxs[j][k]) * 0.5f;
+			halfMaxs[k] = maxs[j][k] - center[k] + 1.f;
+			halfMins[k] = -halfMaxs[k];
+		}
+
+		trap_CM_BoxTrace(&tr, center, center, halfMins, halfMaxs, 0, CONTENTS_FOG);
+		batch[j] = !tr.startsolid;
+	}
+
+	for (i = 0, poly = particlePolys; i < numParticlePolys; i++, poly++)
+	{
+		for (j = 0; j < numShaders && shaders[j] != poly->shader; j++)
+		{
+		}
+
+		if (j < numShaders && batch[j])
+		{
+			CG_AddParticlePolyToBuffer(poly);
+		}
+		else
+		{
+			trap_R_AddPolyToScene(poly->shader, poly->numVerts, poly->verts);
+		}
+	}
+
+	numParticlePolys = 0;
+}
+
 /**
  * @brief CG_AddParticleToScene
  * @param[in,out] p
@@ -993,11 +1140,11 @@ void CG_AddParticleToScene(cparticle_t *p, vec3_t org, float alpha)
 
 	if (p->type == P_WEATHER || p->type == P_WEATHER_TURBULENT || p->type == P_WEATHER_FLURRY)
 	{
-		trap_R_AddPolyToScene(p->pshader, 3, TRIverts);
+		CG_AddParticlePoly(p->pshader, 3, TRIverts);
 	}
 	else
 	{
-		trap_R_AddPolyToScene(p->pshader, 4, verts);
+		CG_AddParticlePoly(p->pshader, 4, verts);
 	}
 }
 
@@ -1126,6 +1273,8 @@ void CG_AddParticles(void)
 	}
 
 	active_particles = active;
+
+	CG_FlushParticlePolys();
 }
 
 /**
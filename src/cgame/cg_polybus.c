@@ -38,6 +38,7 @@
 
 polyBuffer_t cg_polyBuffers[MAX_PB_BUFFERS];
 qboolean     cg_polyBuffersInuse[MAX_PB_BUFFERS];
+qboolean     cg_polyBuffersSubmitted[MAX_PB_BUFFERS];   ///< added to a scene this frame, the renderer reads them at the end of the frame
 
 /**
  * @brief CG_PB_FindFreePolyBuffer
@@ -54,6 +55,12 @@ polyBuffer_t *CG_PB_FindFreePolyBuffer(qhandle_t shader, int numVerts, int numIn
 	// first find one with the same shader if possible
 	for (i = 0; i < MAX_PB_BUFFERS; ++i)
 	{
+		// belongs to a scene that was already rendered
+		if (cg_polyBuffersSubmitted[i])
+		{
+			continue;
+		}
+
 		if (!cg_polyBuffersInuse[i])
 		{
 			if (firstFree == -1)
@@ -105,10 +112,14 @@ void CG_PB_ClearPolyBuffers(void)
 {
 	// changed numIndicies and numVerts to be reset in CG_PB_FindFreePolyBuffer, not here (should save the cache misses we were prolly getting)
 	Com_Memset(cg_polyBuffersInuse, 0, sizeof(cg_polyBuffersInuse));
+	Com_Memset(cg_polyBuffersSubmitted, 0, sizeof(cg_polyBuffersSubmitted));
 }
 
 /**
- * @brief CG_PB_RenderPolyBuffers
+ * @brief Adds the poly buffers filled since the last call to the scene
+ *
+ * @note Call once per scene before trap_R_RenderScene, the submitted buffers
+ * stay untouched until CG_PB_ClearPolyBuffers starts the next frame.
  */
 void CG_PB_RenderPolyBuffers(void)
 {
@@ -116,9 +127,10 @@ void CG_PB_RenderPolyBuffers(void)
 
 	for (i = 0; i < MAX_PB_BUFFERS; i++)
 	{
-		if (cg_polyBuffersInuse[i])
+		if (cg_polyBuffersInuse[i] && !cg_polyBuffersSubmitted[i])
 		{
 			trap_R_AddPolyBufferToScene(&cg_polyBuffers[i]);
+			cg_polyBuffersSubmitted[i] = qtrue;
 		}
 	}
 }
@@ -172,6 +172,37 @@ float CG_ClientHitboxMaxZ(entityState_t *hitEnt, float def)
 }
 
 
+/**
+ * @brief Gets the bounds swept by a trace, used to skip solid entities
+ * the trace can't touch before asking the collision code
+ * @param[in] start
+ * @param[in] mins may be NULL for a point trace
+ * @param[in] maxs may be NULL for a point trace
+ * @param[in] end
+ * @param[out] sweptMins
+ * @param[out] sweptMaxs
+ */
+static void CG_TraceSweptBounds(const vec3_t start, const vec3_t mins, const vec3_t maxs, const vec3_t end, vec3_t sweptMins, vec3_t sweptMaxs)
+{
+	int i;
+
+	for (i = 0; i < 3; i++)
+	{
+		sweptMins[i] = MIN(start[i], end[i]) - 1.f;
+		sweptMaxs[i] = MAX(start[i], end[i]) + 1.f;
+
+		if (mins)
+		{
+			sweptMins[i] += mins[i];
+		}
+
+		if (maxs)
+		{
+			sweptMaxs[i] += maxs[i];
+		}
+	}
+}
+
 /**
  * @brief CG_ClipMoveToEntities
  * @param[in] start
@@ -192,8 +223,11 @@ static void CG_ClipMoveToEntities(const vec3_t start, const vec3_t mins, const v
 	clipHandle_t  cmodel;
 	vec3_t        bmins, bmaxs;
 	vec3_t        origin, angles;
+	vec3_t        sweptMins, sweptMaxs;
 	centity_t     *cent;
 
+	CG_TraceSweptBounds(start, mins, maxs, end, sweptMins, sweptMaxs);
+
 	for (i = 0 ; i < cg_numSolidEntities ; i++)
 	{
 		cent = cg_solidEntities[i];
@@ -234,6 +268,15 @@ static void CG_ClipMoveToEntities(const vec3_t start, const vec3_t mins, const v
 				bmaxs[2] = zu;
 			}
 
+			// most boxes are nowhere near the trace, skip them without
+			// building a temp model and tracing against it
+			if (cent->lerpOrigin[0] + bmins[0] > sweptMaxs[0] || cent->lerpOrigin[0] + bmaxs[0] < sweptMins[0] ||
+			    cent->lerpOrigin[1] + bmins[1] > sweptMaxs[1] || cent->lerpOrigin[1] + bmaxs[1] < sweptMins[1] ||
+			    cent->lerpOrigin[2] + bmins[2] > sweptMaxs[2] || cent->lerpOrigin[2] + bmaxs[2] < sweptMins[2])
+			{
+				continue;
+			}
+
 			//cmodel = trap_CM_TempCapsuleModel( bmins, bmaxs );
 			cmodel = trap_CM_TempBoxModel(bmins, bmaxs);
 
@@ -1047,6 +1090,7 @@ void CG_PredictPlayerState(void)
 	// unlagged - optimized prediction
 	int stateIndex = 0, predictCmd = 0;
 	int numPredicted = 0, numPlayedBack = 0; // debug code
+	qboolean predicted;
 
 	cg.hyperspace = qfalse; // will be set if touching a trigger_teleport
 
@@ -1451,6 +1495,7 @@ void CG_PredictPlayerState(void)
 
 		// unlagged - optimized prediction
 		// we check for cg_latentCmds because it'll mess up the optimization
+		predicted = qtrue;
 		if (cg_optimizePrediction.integer)
 		{
 			// if we need to predict this command, or we've run out of space in the saved states queue
@@ -1477,6 +1522,7 @@ void CG_PredictPlayerState(void)
 			else
 			{
 				numPlayedBack++; // debug code
+				predicted = qfalse;
 
 				if (cg_showmiss.integer && cg.backupStates[stateIndex].commandTime != cg_pmove.cmd.serverTime)
 				{
@@ -1503,9 +1549,16 @@ void CG_PredictPlayerState(void)
 		moved = qtrue;
 
 		// add push trigger movement effects
-		CG_TouchTriggerPrediction();
+		// played back states were already checked when they were predicted
+		if (predicted)
+		{
+			CG_TouchTriggerPrediction();
+		}
 	}
 
+	cg.numPredictedCmds  += numPredicted;
+	cg.numPlayedBackCmds += numPlayedBack;
+
 	// unlagged - optimized prediction
 	// do a /condump after a few seconds of this
 	if (cg_showmiss.integer & 2)
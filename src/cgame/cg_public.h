@@ -276,6 +276,8 @@ typedef enum
 
 #ifndef CGAMEDLL
 	CG_TRAP_GETVALUE = COM_TRAP_GETVALUE,
+	CG_CVAR_GET_CHANGES,        ///< trap_Cvar_GetChanges_Legacy
+	CG_TRANSLATION_GENERATION,  ///< trap_TranslationGeneration_Legacy
 #endif
 
 } cgameImport_t;
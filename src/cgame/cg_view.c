@@ -2045,6 +2045,9 @@ void CG_DrawActiveFrame(int serverTime, qboolean demoPlayback)
 
 	CG_ProcessCvars();
 
+	// a language change takes effect in the next frame
+	cg.translationGeneration = trap_TranslationGeneration();
+
 #ifdef DEBUGTIME_ENABLED
 	CG_Printf("\n");
 #endif
@@ -597,6 +597,7 @@ void CL_ShutdownCGame(void)
 	VM_Call(cgvm, CG_SHUTDOWN);
 	VM_Free(cgvm);
 	cgvm = NULL;
+	Cvar_ClearChanges(VM_CGAME);
 }
 
 static int FloatAsInt(float f)
@@ -616,7 +617,14 @@ static int FloatAsInt(float f)
  */
 static qboolean CL_CG_GetValue(char *value, int valueSize, const char *key)
 {
-	return qfalse;
+	static const ext_trap_keys_t cg_extensionTraps[] =
+	{
+		{ "trap_Cvar_GetChanges_Legacy",       CG_CVAR_GET_CHANGES       },
+		{ "trap_TranslationGeneration_Legacy", CG_TRANSLATION_GENERATION },
+		{ NULL,                                -1                        }
+	};
+
+	return VM_GetExtensionTrap(cg_extensionTraps, value, valueSize, key);
 }
 
 /**
@@ -636,7 +644,7 @@ intptr_t CL_CgameSystemCalls(intptr_t *args)
 	case CG_MILLISECONDS:
 		return Sys_Milliseconds();
 	case CG_CVAR_REGISTER:
-		Cvar_Register(VMA(1), VMA(2), VMA(3), args[4]);
+		Cvar_Register(VMA(1), VMA(2), VMA(3), args[4], VM_CGAME);
 		return 0;
 	case CG_CVAR_UPDATE:
 		Cvar_Update(VMA(1));
@@ -1042,6 +1050,10 @@ intptr_t CL_CgameSystemCalls(intptr_t *args)
 
 	case CG_TRAP_GETVALUE:
 		return CL_CG_GetValue(VMA(1), args[2], VMA(3));
+	case CG_CVAR_GET_CHANGES:
+		return Cvar_GetChanges(VM_CGAME, VMA(1), args[2]);
+	case CG_TRANSLATION_GENERATION:
+		return CL_TranslationGeneration();
 
 	default:
 		Com_Error(ERR_DROP, "Bad cgame system trap: %ld", (long int) args[0]);
@@ -4345,6 +4345,20 @@ void CL_TranslateStringMod(const char *string, char *dest_buffer)
 	Com_sprintf(dest_buffer, MAX_STRING_CHARS, "%s", __(string));
 }
 
+/**
+ * @brief Lets mod libs know when translations they cached became stale.
+ *
+ * @return language generation, changes whenever the language is switched
+ */
+int CL_TranslationGeneration(void)
+{
+#ifdef FEATURE_GETTEXT
+	return I18N_Generation();
+#else
+	return 0;
+#endif
+}
+
 /**
  * @brief Stores in a static buf, converts \\n to chr(13)
  * @todo Replace / remove.
@@ -47,9 +47,8 @@
 static void CL_Netchan_Encode(msg_t *msg)
 {
 	int      serverId, messageAcknowledge, reliableAcknowledge;
-	int      i, index, srdc, sbit;
+	int      srdc, sbit;
 	qboolean soob;
-	byte     key, *string;
 
 	if (msg->cursize <= CL_ENCODE_START)
 	{
@@ -72,24 +71,10 @@ static void CL_Netchan_Encode(msg_t *msg)
 	msg->bit       = sbit;
 	msg->readcount = srdc;
 
-	string = (byte *)clc.serverCommands[reliableAcknowledge & (MAX_RELIABLE_COMMANDS - 1)];
-	index  = 0;
-
-	key = clc.challenge ^ serverId ^ messageAcknowledge;
-	for (i = CL_ENCODE_START; i < msg->cursize; i++)
-	{
-		// modify the key with the last received now acknowledged server command
-		if (!string[index])
-		{
-			index = 0;
-		}
-
-		key ^= string[index] << (i & 1);
-
-		index++;
-		// encode the data with this key
-		*(msg->data + i) = (*(msg->data + i)) ^ key;
-	}
+	// modify the key with the last received now acknowledged server command
+	Netchan_XorPayload(msg->data, CL_ENCODE_START, msg->cursize,
+	                   (byte)(clc.challenge ^ serverId ^ messageAcknowledge),
+	                   (const byte *)clc.serverCommands[reliableAcknowledge & (MAX_RELIABLE_COMMANDS - 1)], 0);
 }
 
 /**
@@ -100,10 +85,10 @@ static void CL_Netchan_Encode(msg_t *msg)
  */
 static void CL_Netchan_Decode(msg_t *msg)
 {
-	long     reliableAcknowledge, i, index;
-	byte     key, *string;
-	int      srdc, sbit;
+	long     reliableAcknowledge;
+	int      srdc, sbit, start, i;
 	qboolean soob;
+	char     *string;
 
 	srdc = msg->readcount;
 	sbit = msg->bit;
@@ -117,29 +102,23 @@ static void CL_Netchan_Decode(msg_t *msg)
 	msg->bit       = sbit;
 	msg->readcount = srdc;
 
-	string = (byte *) clc.reliableCommands[reliableAcknowledge & (MAX_RELIABLE_COMMANDS - 1)];
-	index  = 0;
-	// xor the client challenge with the netchan sequence number (need something that changes every message)
-	key = clc.challenge ^ LittleLong(*(unsigned *)msg->data);
-	for (i = msg->readcount + CL_DECODE_START; i < msg->cursize; i++)
-	{
-		// modify the key with the last sent and with this message acknowledged client command
-		if (!string[index])
-		{
-			index = 0;
-		}
+	string = clc.reliableCommands[reliableAcknowledge & (MAX_RELIABLE_COMMANDS - 1)];
+	start  = msg->readcount + CL_DECODE_START;
 
-		if ((!Com_IsCompatible(&clc.agent, 0x1) && (byte)string[index] > 127) || string[index] == '%')
+	// strip the part of the command used as key
+	for (i = 0; i < msg->cursize - start && string[i]; i++)
+	{
+		if ((!Com_IsCompatible(&clc.agent, 0x1) && (byte)string[i] > 127) || string[i] == '%')
 		{
-			string[index] = '.';
+			string[i] = '.';
 		}
-
-		key ^= string[index] << (i & 1);
-
-		index++;
-		// decode the data with this key
-		*(msg->data + i) = *(msg->data + i) ^ key;
 	}
+
+	// xor the client challenge with the netchan sequence number (need something that changes every message)
+	// and modify the key with the last sent and with this message acknowledged client command
+	Netchan_XorPayload(msg->data, start, msg->cursize,
+	                   (byte)(clc.challenge ^ LittleLong(*(unsigned *)msg->data)),
+	                   (const byte *)string, 0);
 }
 
 /**
@@ -1063,7 +1063,14 @@ static int FloatAsInt(float f)
  */
 static qboolean CL_UI_GetValue(char *value, int valueSize, const char *key)
 {
-	return qfalse;
+	static const ext_trap_keys_t ui_extensionTraps[] =
+	{
+		{ "trap_Cvar_GetChanges_Legacy",       UI_CVAR_GET_CHANGES       },
+		{ "trap_TranslationGeneration_Legacy", UI_TRANSLATION_GENERATION },
+		{ NULL,                                -1                        }
+	};
+
+	return VM_GetExtensionTrap(ui_extensionTraps, value, valueSize, key);
 }
 
 /**
@@ -1083,7 +1090,7 @@ intptr_t CL_UISystemCalls(intptr_t *args)
 	case UI_MILLISECONDS:
 		return Sys_Milliseconds();
 	case UI_CVAR_REGISTER:
-		Cvar_Register(VMA(1), VMA(2), VMA(3), args[4]);
+		Cvar_Register(VMA(1), VMA(2), VMA(3), args[4], VM_UI);
 		return 0;
 	case UI_CVAR_UPDATE:
 		Cvar_Update(VMA(1));
@@ -1106,7 +1113,7 @@ intptr_t CL_UISystemCalls(intptr_t *args)
 		Cvar_Reset(VMA(1));
 		return 0;
 	case UI_CVAR_CREATE:
-		Cvar_Register(NULL, VMA(1), VMA(2), args[3]);
+		Cvar_Register(NULL, VMA(1), VMA(2), args[3], VM_UI);
 		return 0;
 	case UI_CVAR_INFOSTRINGBUFFER:
 		Cvar_InfoStringBuffer(args[1], VMA(2), args[3]);
@@ -1377,6 +1384,10 @@ intptr_t CL_UISystemCalls(intptr_t *args)
 		return 0;
 	case UI_TRAP_GETVALUE:
 		return CL_UI_GetValue(VMA(1), args[2], VMA(3));
+	case UI_CVAR_GET_CHANGES:
+		return Cvar_GetChanges(VM_UI, VMA(1), args[2]);
+	case UI_TRANSLATION_GENERATION:
+		return CL_TranslationGeneration();
 	default:
 		Com_Error(ERR_DROP, "Bad UI system trap: %ld", (long int) args[0]);
 	}
@@ -1398,6 +1409,7 @@ void CL_ShutdownUI(void)
 	VM_Call(uivm, UI_SHUTDOWN);
 	VM_Free(uivm);
 	uivm = NULL;
+	Cvar_ClearChanges(VM_UI);
 }
 
 /**
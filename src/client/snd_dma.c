@@ -36,12 +36,16 @@
 #include "snd_local.h"
 #include "snd_codec.h"
 #include "client.h"
+#include "../sdl/sdl_defs.h"
 
 void S_Update_(void);
 void S_Base_StopAllSounds(void);
 void S_StopStreamingSound(int stream);
 void S_FreeStreamingSound(int stream);
 void S_UpdateStreamingSounds(void);
+static void S_LockMixer(void);
+static void S_UnlockMixer(void);
+static qboolean S_MixerThreadStarted(void);
 
 streamingSound_t streamingSounds[MAX_STREAMING_SOUNDS];
 
@@ -90,6 +94,9 @@ cvar_t *s_show;
 cvar_t *s_mixahead;
 cvar_t *s_mixOffset;
 cvar_t *s_debugStreams;
+cvar_t *s_mixerThread;
+
+static SDL_atomic_t s_mixerRunning;     ///< the mixer thread is painting, S_Base_Update only queues
 
 static loopSound_t loopSounds[MAX_LOOP_SOUNDS];
 static vec3_t      entityPositions[MAX_GENTITIES];
@@ -525,6 +532,189 @@ void S_memoryLoad(sfx_t *sfx)
 		sfx->defaultSound = qtrue;
 	}
 	sfx->inMemory = qtrue;
+
+	// with the mixer thread the cache is written once the mixer lock is released
+	if (!S_MixerThreadStarted())
+	{
+		S_FlushSoundCache();
+	}
+}
+
+#define MIXBENCH_SAMPLES     1024
+#define MIXBENCH_DMA_SAMPLES 16384  ///< mono samples of the scratch buffer without a started device
+#define MIXBENCH_TONE_CHUNKS 8
+
+/**
+ * @brief Generates a mono 16 bit tone for s_mixbench when no sound can be loaded
+ * @param[out] sfx
+ * @return sfx, or NULL if out of memory
+ */
+static sfx_t *S_MixBenchTone(sfx_t *sfx)
+{
+	sndBuffer *chunks;
+	int       i, j;
+
+	chunks = Com_Allocate(MIXBENCH_TONE_CHUNKS * sizeof(sndBuffer));
+	if (!chunks)
+	{
+		return NULL;
+	}
+	Com_Memset(chunks, 0, MIXBENCH_TONE_CHUNKS * sizeof(sndBuffer));
+
+	for (i = 0; i < MIXBENCH_TONE_CHUNKS; i++)
+	{
+		for (j = 0; j < SND_CHUNK_SIZE; j++)
+		{
+			chunks[i].sndChunk[j] = (short)(sin((i * SND_CHUNK_SIZE + j) * 0.1) * 20000);
+		}
+		chunks[i].size = SND_CHUNK_SIZE;
+		chunks[i].next = (i + 1 < MIXBENCH_TONE_CHUNKS) ? &chunks[i + 1] : NULL;
+	}
+
+	Com_Memset(sfx, 0, sizeof(*sfx));
+	Q_strncpyz(sfx->soundName, "*tone", sizeof(sfx->soundName));
+	sfx->soundData     = chunks;
+	sfx->soundLength   = MIXBENCH_TONE_CHUNKS * SND_CHUNK_SIZE;
+	sfx->soundChannels = 1;
+	sfx->inMemory      = qtrue;
+
+	return sfx;
+}
+
+/**
+ * @brief Mixes a number of looping channels of a sound into a scratch buffer and prints the
+ * time spent in the mixer. The dma buffer and the channel state are restored afterwards.
+ *
+ * s_mixbench [channels] [frames] [sound]
+ *
+ * @note Without a started sound device (s_initsound 0, the OpenAL backend or no audio
+ * hardware) a generated tone is mixed into a 16 bit stereo buffer instead of the sound.
+ */
+void S_Base_MixBench_f(void)
+{
+	static channel_t savedLoopChannels[MAX_CHANNELS];
+	int              numChannels = 32;
+	int              frames      = 200;
+	const char       *name       = "sound/player/default/blank.wav";
+	int              savedNumLoopChannels, savedPaintedTime;
+	float            savedVolCurrent;
+	dma_t            savedDma;
+	sfx_t            toneSfx;
+	sfxHandle_t      handle;
+	sfx_t            *sfx;
+	channel_t        *ch;
+	int              i, start, msec;
+
+	if (Cmd_Argc() > 1)
+	{
+		numChannels = Q_atoi(Cmd_Argv(1));
+		numChannels = Com_Clamp(1, MAX_CHANNELS, numChannels);
+	}
+	if (Cmd_Argc() > 2)
+	{
+		frames = Q_atoi(Cmd_Argv(2));
+		frames = Com_Clamp(1, 100000, frames);
+	}
+	if (Cmd_Argc() > 3)
+	{
+		name = Cmd_Argv(3);
+	}
+
+	savedDma = dma;
+
+	if (s_soundStarted)
+	{
+		S_LockMixer();
+
+		handle = S_Base_RegisterSound(name, qfalse);
+		sfx    = &knownSfx[handle];
+		if ((!handle && Q_stricmp(name, sfx->soundName)) || !sfx->soundData || !sfx->soundLength)
+		{
+			S_UnlockMixer();
+			Com_Printf("s_mixbench: can't load %s\n", name);
+			return;
+		}
+
+		// paint into a scratch buffer, the device is locked out for the duration of the bench
+		SNDDMA_BeginPainting();
+	}
+	else
+	{
+		sfx = S_MixBenchTone(&toneSfx);
+		if (!sfx)
+		{
+			Com_Printf("s_mixbench: out of memory\n");
+			return;
+		}
+
+		if (!s_testsound)
+		{
+			s_testsound = Cvar_Get("s_testsound", "0", CVAR_CHEAT);
+		}
+
+		dma.channels         = 2;
+		dma.samplebits       = 16;
+		dma.speed            = 22050;
+		dma.samples          = MIXBENCH_DMA_SAMPLES;
+		dma.submission_chunk = 1;
+	}
+
+	savedNumLoopChannels = numLoopChannels;
+	savedPaintedTime     = s_paintedtime;
+	savedVolCurrent      = s_volCurrent;
+	Com_Memcpy(savedLoopChannels, loop_channels, sizeof(loop_channels));
+
+	dma.buffer = Com_Allocate(dma.samples * (dma.samplebits / 8));
+	if (dma.buffer)
+	{
+		Com_Memset(dma.buffer, 0, dma.samples * (dma.samplebits / 8));
+
+		Com_Memset(loop_channels, 0, sizeof(loop_channels));
+		for (i = 0, ch = loop_channels; i < numChannels; i++, ch++)
+		{
+			ch->thesfx          = sfx;
+			ch->master_vol      = 127;
+			ch->leftvol         = 127 - i;
+			ch->rightvol        = 64 + i;
+			ch->dopplerScale    = 1.0f;
+			ch->oldDopplerScale = 1.0f;
+		}
+		numLoopChannels = numChannels;
+		s_volCurrent    = 1.0f;
+
+		start = Sys_Milliseconds();
+		for (i = 0; i < frames; i++)
+		{
+			S_PaintChannels(s_paintedtime + MIXBENCH_SAMPLES);
+		}
+		msec = Sys_Milliseconds() - start;
+
+		Com_Dealloc(dma.buffer);
+
+		Com_Printf("%d channels of %s (compression %d), %d x %d samples: %d msec, %.3f usec per channel and %d samples\n",
+		           numChannels, sfx->soundName, sfx->soundCompressionMethod, frames, MIXBENCH_SAMPLES, msec,
+		           msec * 1000.0 / ((double)frames * numChannels), MIXBENCH_SAMPLES);
+	}
+	else
+	{
+		Com_Printf("s_mixbench: out of memory\n");
+	}
+
+	dma             = savedDma;
+	numLoopChannels = savedNumLoopChannels;
+	s_paintedtime   = savedPaintedTime;
+	s_volCurrent    = savedVolCurrent;
+	Com_Memcpy(loop_channels, savedLoopChannels, sizeof(loop_channels));
+
+	if (s_soundStarted)
+	{
+		SNDDMA_Submit();
+		S_UnlockMixer();
+	}
+	else
+	{
+		Com_Dealloc(toneSfx.soundData);
+	}
 }
 
 //=============================================================================
@@ -1539,8 +1729,12 @@ void S_Base_Update(void)
 	// add raw data from streamed samples
 	S_UpdateStreamingSounds();
 
-	// mix some sound
-	S_Update_();
+	// mix some sound, the mixer thread does this on its own unless
+	// the audio has to be captured in step with the video frames
+	if (!SDL_AtomicGet(&s_mixerRunning) || CL_VideoRecording())
+	{
+		S_Update_();
+	}
 }
 
 /**
@@ -2251,6 +2445,8 @@ int S_Base_GetCurrentSoundTime(void)
 	return s_soundtime + dma.speed;
 }
 
+static qboolean S_SfxPinned(sfx_t *sfx);
+
 /**
  * @brief S_FreeOldestSound
  */
@@ -2265,7 +2461,7 @@ void S_FreeOldestSound(void)
 	for (i = 1 ; i < numSfx ; i++)
 	{
 		sfx = &knownSfx[i];
-		if (sfx->inMemory && sfx->lastTimeUsed < oldest)
+		if (sfx->inMemory && sfx->lastTimeUsed < oldest && !S_SfxPinned(sfx))
 		{
 			used   = i;
 			oldest = sfx->lastTimeUsed;
@@ -2287,6 +2483,741 @@ void S_FreeOldestSound(void)
 	sfx->soundData = NULL;
 }
 
+// =======================================================================
+// Mixer thread
+// =======================================================================
+
+/*
+ * With s_mixerThread enabled the mixer paints from its own thread and the
+ * main thread no longer owns the channel state. The per frame calls
+ * (start sound, loop sounds, respatialize) are put on a single producer
+ * command queue which the mixer thread executes, everything else runs on
+ * the main thread while holding the mixer lock.
+ */
+
+#define SND_COMMAND_QUEUE   4096    ///< must be a power of two
+#define SND_MIXER_MSEC      5       ///< sleep between two mixer passes
+
+typedef enum
+{
+	SND_CMD_START_SOUND,
+	SND_CMD_START_LOCAL_SOUND,
+	SND_CMD_CLEAR_LOOPING_SOUNDS,
+	SND_CMD_ADD_LOOPING_SOUND,
+	SND_CMD_ADD_REAL_LOOPING_SOUND,
+	SND_CMD_UPDATE_ENTITY_POSITION,
+	SND_CMD_RESPATIALIZE
+} sndCommandType_t;
+
+/**
+ * @struct sndCommand_s
+ * @brief Arguments of a queued sound call
+ */
+typedef struct sndCommand_s
+{
+	sndCommandType_t type;
+	int entnum;
+	int channel;
+	sfxHandle_t sfx;
+	int flags;
+	int volume;
+	int range;
+	int time;                   ///< soundTime for loop sounds, inwater for respatialize
+	qboolean hasOrigin;
+	vec3_t origin;
+	vec3_t vectors[3];          ///< velocity for loop sounds, axis for respatialize
+} sndCommand_t;
+
+static sndCommand_t s_commands[SND_COMMAND_QUEUE];
+static unsigned int s_commandWrite;     ///< producer only, published to s_commandHead once a frame
+static SDL_atomic_t s_commandHead;
+static SDL_atomic_t s_commandTail;
+
+static SDL_Thread *s_mixerThreadHandle;
+static SDL_mutex  *s_mixerLock;
+static int        s_mixerLockDepth;     ///< main thread lock depth, a Com_Error may unwind past the unlock
+
+/**
+ * @brief Makes the commands queued so far visible to the mixer thread
+ */
+static void S_PublishCommands(void)
+{
+	SDL_AtomicSet(&s_commandHead, (int)s_commandWrite);
+}
+
+/**
+ * @brief Checks if a sound is still needed by a command the mixer thread hasn't executed
+ * @param[in,out] sfx
+ * @return
+ */
+static qboolean S_SfxPinned(sfx_t *sfx)
+{
+	if (sfx->pinned && (int)(sfx->pinCommand - (unsigned int)SDL_AtomicGet(&s_commandTail)) <= 0)
+	{
+		sfx->pinned = qfalse;
+	}
+
+	return sfx->pinned;
+}
+
+/**
+ * @brief Checks the sound of a queued command is still loaded. The mixer thread
+ * drops the command otherwise, loading it there would touch the file system.
+ * @param[in] cmd
+ * @return
+ */
+static qboolean S_CommandSfxInMemory(const sndCommand_t *cmd)
+{
+	return knownSfx[cmd->sfx].inMemory;
+}
+
+/**
+ * @brief Executes the published commands, the caller holds the mixer lock
+ */
+static void S_RunCommands(void)
+{
+	unsigned int head = (unsigned int)SDL_AtomicGet(&s_commandHead);
+	unsigned int tail = (unsigned int)SDL_AtomicGet(&s_commandTail);
+	sndCommand_t *cmd;
+
+	for ( ; tail != head; tail++)
+	{
+		cmd = &s_commands[tail & (SND_COMMAND_QUEUE - 1)];
+
+		switch (cmd->type)
+		{
+		case SND_CMD_START_SOUND:
+			if (!S_CommandSfxInMemory(cmd))
+			{
+				break;
+			}
+			S_Base_StartSoundEx(cmd->hasOrigin ? cmd->origin : NULL, cmd->entnum, cmd->channel, cmd->sfx, cmd->flags, cmd->volume);
+			break;
+		case SND_CMD_START_LOCAL_SOUND:
+			if (!S_CommandSfxInMemory(cmd))
+			{
+				break;
+			}
+			S_Base_StartLocalSound(cmd->sfx, cmd->channel, cmd->volume);
+			break;
+		case SND_CMD_CLEAR_LOOPING_SOUNDS:
+			S_Base_ClearLoopingSounds();
+			break;
+		case SND_CMD_ADD_LOOPING_SOUND:
+			if (!S_CommandSfxInMemory(cmd))
+			{
+				break;
+			}
+			S_Base_AddLoopingSound(cmd->origin, cmd->vectors[0], cmd->range, cmd->sfx, cmd->volume, cmd->time);
+			break;
+		case SND_CMD_ADD_REAL_LOOPING_SOUND:
+			if (!S_CommandSfxInMemory(cmd))
+			{
+				break;
+			}
+			S_Base_AddRealLoopingSound(cmd->origin, cmd->vectors[0], cmd->range, cmd->sfx, cmd->volume, cmd->time);
+			break;
+		case SND_CMD_UPDATE_ENTITY_POSITION:
+			S_Base_UpdateEntityPosition(cmd->entnum, cmd->origin);
+			break;
+		case SND_CMD_RESPATIALIZE:
+			S_Base_Respatialize(cmd->entnum, cmd->origin, cmd->vectors, cmd->time);
+			break;
+		default:
+			break;
+		}
+	}
+
+	SDL_AtomicSet(&s_commandTail, (int)tail);
+}
+
+/**
+ * @brief Takes the mixer lock from the main thread. Everything queued so far
+ * is executed first so the call keeps its order relative to the queued ones.
+ */
+static void S_LockMixer(void)
+{
+	if (!s_mixerLock)
+	{
+		return;
+	}
+
+	SDL_LockMutex(s_mixerLock);
+	s_mixerLockDepth++;
+
+	S_PublishCommands();
+	S_RunCommands();
+}
+
+/**
+ * @brief S_UnlockMixer
+ */
+static void S_UnlockMixer(void)
+{
+	if (!s_mixerLock)
+	{
+		return;
+	}
+
+	s_mixerLockDepth--;
+	SDL_UnlockMutex(s_mixerLock);
+
+	if (!s_mixerLockDepth)
+	{
+		// sounds loaded under the lock, don't make the mixer wait for the disk
+		S_FlushSoundCache();
+	}
+}
+
+/**
+ * @brief S_MixerThreadStarted
+ * @return qtrue if the mixing runs on the mixer thread
+ */
+static qboolean S_MixerThreadStarted(void)
+{
+	return s_mixerLock != NULL;
+}
+
+/**
+ * @brief Returns the next free command slot
+ * @param[in] type
+ * @return
+ */
+static sndCommand_t *S_QueueCommand(sndCommandType_t type)
+{
+	sndCommand_t *cmd;
+
+	if (s_commandWrite - (unsigned int)SDL_AtomicGet(&s_commandTail) >= SND_COMMAND_QUEUE)
+	{
+		// the mixer fell behind, run the queue on this thread
+		S_LockMixer();
+		S_UnlockMixer();
+	}
+
+	cmd       = &s_commands[s_commandWrite & (SND_COMMAND_QUEUE - 1)];
+	cmd->type = type;
+	s_commandWrite++;
+
+	return cmd;
+}
+
+/**
+ * @brief Validates a sound handle on the main thread and loads the sound if needed
+ * so the mixer thread never touches the file system. The sound is pinned until
+ * the command queued next has been executed, so a later load can't evict it.
+ * @param[in] sfxHandle
+ * @param[in] caller
+ * @return
+ */
+static sfx_t *S_ThreadPrepareSfx(sfxHandle_t sfxHandle, const char *caller)
+{
+	sfx_t *sfx;
+
+	if (sfxHandle < 0 || sfxHandle >= numSfx)
+	{
+		Com_Printf(S_COLOR_YELLOW "%s: handle %i out of range\n", caller, sfxHandle);
+		return NULL;
+	}
+
+	sfx = &knownSfx[sfxHandle];
+
+	if (sfx->inMemory == qfalse)
+	{
+		S_LockMixer();
+		S_memoryLoad(sfx);
+		S_UnlockMixer();
+	}
+
+	sfx->pinned     = qtrue;
+	sfx->pinCommand = s_commandWrite + 1;
+
+	return sfx;
+}
+
+/**
+ * @brief S_Thread_StartSoundEx
+ * @param[in] origin
+ * @param[in] entnum
+ * @param[in] entchannel
+ * @param[in] sfxHandle
+ * @param[in] flags
+ * @param[in] volume
+ */
+static void S_Thread_StartSoundEx(vec3_t origin, int entnum, int entchannel, sfxHandle_t sfxHandle, int flags, int volume)
+{
+	sndCommand_t *cmd;
+
+	if (!s_soundStarted || s_soundMuted)
+	{
+		return;
+	}
+
+	if (!origin && (entnum < 0 || entnum >= MAX_GENTITIES))
+	{
+		Com_Error(ERR_DROP, "S_Base_StartSoundEx: bad entitynum %i", entnum);
+	}
+
+	if (!S_ThreadPrepareSfx(sfxHandle, "S_Base_StartSoundEx"))
+	{
+		return;
+	}
+
+	cmd            = S_QueueCommand(SND_CMD_START_SOUND);
+	cmd->entnum    = entnum;
+	cmd->channel   = entchannel;
+	cmd->sfx       = sfxHandle;
+	cmd->flags     = flags;
+	cmd->volume    = volume;
+	cmd->hasOrigin = origin != NULL;
+	if (origin)
+	{
+		VectorCopy(origin, cmd->origin);
+	}
+}
+
+/**
+ * @brief S_Thread_StartSound
+ * @param[in] origin
+ * @param[in] entnum
+ * @param[in] entchannel
+ * @param[in] sfxHandle
+ * @param[in] volume
+ */
+static void S_Thread_StartSound(vec3_t origin, int entnum, int entchannel, sfxHandle_t sfxHandle, int volume)
+{
+	S_Thread_StartSoundEx(origin, entnum, entchannel, sfxHandle, 0, volume);
+}
+
+/**
+ * @brief S_Thread_StartLocalSound
+ * @param[in] sfxHandle
+ * @param[in] channelNum
+ * @param[in] volume
+ */
+static void S_Thread_StartLocalSound(sfxHandle_t sfxHandle, int channelNum, int volume)
+{
+	sndCommand_t *cmd;
+
+	if (!s_soundStarted || s_soundMuted)
+	{
+		return;
+	}
+
+	if (!S_ThreadPrepareSfx(sfxHandle, "S_StartLocalSound"))
+	{
+		return;
+	}
+
+	// the listener is only known to the mixer thread
+	cmd          = S_QueueCommand(SND_CMD_START_LOCAL_SOUND);
+	cmd->sfx     = sfxHandle;
+	cmd->channel = channelNum;
+	cmd->volume  = volume;
+}
+
+/**
+ * @brief S_Thread_ClearLoopingSounds
+ */
+static void S_Thread_ClearLoopingSounds(void)
+{
+	S_QueueCommand(SND_CMD_CLEAR_LOOPING_SOUNDS);
+}
+
+/**
+ * @brief S_Thread_QueueLoopingSound
+ * @param[in] type
+ * @param[in] origin
+ * @param[in] velocity
+ * @param[in] range
+ * @param[in] sfxHandle
+ * @param[in] volume
+ * @param[in] soundTime
+ */
+static void S_Thread_QueueLoopingSound(sndCommandType_t type, const vec3_t origin, const vec3_t velocity, int range, sfxHandle_t sfxHandle, int volume, int soundTime)
+{
+	sndCommand_t *cmd;
+	sfx_t        *sfx;
+
+	if (!s_soundStarted || s_soundMuted || !volume)
+	{
+		return;
+	}
+
+	sfx = S_ThreadPrepareSfx(sfxHandle, "S_AddLoopingSound");
+	if (!sfx)
+	{
+		return;
+	}
+
+	if (!sfx->soundLength)
+	{
+		Com_Error(ERR_DROP, "%s has length 0", sfx->soundName);
+	}
+
+	cmd         = S_QueueCommand(type);
+	cmd->range  = range;
+	cmd->sfx    = sfxHandle;
+	cmd->volume = volume;
+	cmd->time   = soundTime;
+	VectorCopy(origin, cmd->origin);
+	VectorCopy(velocity, cmd->vectors[0]);
+}
+
+/**
+ * @brief S_Thread_AddLoopingSound
+ * @param[in] origin
+ * @param[in] velocity
+ * @param[in] range
+ * @param[in] sfxHandle
+ * @param[in] volume
+ * @param[in] soundTime
+ */
+static void S_Thread_AddLoopingSound(const vec3_t origin, const vec3_t velocity, int range, sfxHandle_t sfxHandle, int volume, int soundTime)
+{
+	S_Thread_QueueLoopingSound(SND_CMD_ADD_LOOPING_SOUND, origin, velocity, range, sfxHandle, volume, soundTime);
+}
+
+/**
+ * @brief S_Thread_AddRealLoopingSound
+ * @param[in] origin
+ * @param[in] velocity
+ * @param[in] range
+ * @param[in] sfxHandle
+ * @param[in] volume
+ * @param[in] soundTime
+ */
+static void S_Thread_AddRealLoopingSound(const vec3_t origin, const vec3_t velocity, int range, sfxHandle_t sfxHandle, int volume, int soundTime)
+{
+	S_Thread_QueueLoopingSound(SND_CMD_ADD_REAL_LOOPING_SOUND, origin, velocity, range, sfxHandle, volume, soundTime);
+}
+
+/**
+ * @brief S_Thread_UpdateEntityPosition
+ * @param[in] entnum
+ * @param[in] origin
+ */
+static void S_Thread_UpdateEntityPosition(int entnum, const vec3_t origin)
+{
+	sndCommand_t *cmd;
+
+	if (entnum < 0 || entnum >= MAX_GENTITIES)
+	{
+		Com_Error(ERR_DROP, "S_UpdateEntityPosition: bad entitynum %i", entnum);
+	}
+
+	cmd         = S_QueueCommand(SND_CMD_UPDATE_ENTITY_POSITION);
+	cmd->entnum = entnum;
+	VectorCopy(origin, cmd->origin);
+}
+
+/**
+ * @brief S_Thread_Respatialize
+ * @param[in] entnum
+ * @param[in] head
+ * @param[in] axis
+ * @param[in] inwater
+ */
+static void S_Thread_Respatialize(int entnum, const vec3_t head, vec3_t axis[3], int inwater)
+{
+	sndCommand_t *cmd;
+
+	if (!s_soundStarted || s_soundMuted)
+	{
+		return;
+	}
+
+	cmd         = S_QueueCommand(SND_CMD_RESPATIALIZE);
+	cmd->entnum = entnum;
+	cmd->time   = inwater;
+	VectorCopy(head, cmd->origin);
+	AxisCopy(axis, cmd->vectors);
+}
+
+/**
+ * @brief Hands the commands of this frame to the mixer thread and updates the streams
+ */
+static void S_Thread_Update(void)
+{
+	S_PublishCommands();
+
+	SDL_LockMutex(s_mixerLock);
+	s_mixerLockDepth++;
+	if (CL_VideoRecording())
+	{
+		// capture mixes in step with the frames on this thread
+		S_RunCommands();
+	}
+	S_Base_Update();
+	s_mixerLockDepth--;
+	SDL_UnlockMutex(s_mixerLock);
+}
+
+// the remaining calls touch the mixer state directly and run under the lock
+
+/**
+ * @brief S_Thread_Reload
+ */
+static void S_Thread_Reload(void)
+{
+	S_LockMixer();
+	S_Base_Reload();
+	S_UnlockMixer();
+}
+
+/**
+ * @brief S_Thread_StartBackgroundTrack
+ */
+static void S_Thread_StartBackgroundTrack(const char *intro, const char *loop, int fadeupTime)
+{
+	S_LockMixer();
+	S_Base_StartBackgroundTrack(intro, loop, fadeupTime);
+	S_UnlockMixer();
+}
+
+/**
+ * @brief S_Thread_StopBackgroundTrack
+ */
+static void S_Thread_StopBackgroundTrack(void)
+{
+	S_LockMixer();
+	S_Base_StopBackgroundTrack();
+	S_UnlockMixer();
+}
+
+/**
+ * @brief S_Thread_StartStreamingSound
+ */
+static float S_Thread_StartStreamingSound(const char *intro, const char *loop, int entnum, int channel, int attenuation)
+{
+	float length;
+
+	S_LockMixer();
+	length = S_Base_StartStreamingSound(intro, loop, entnum, channel, attenuation);
+	S_UnlockMixer();
+
+	return length;
+}
+
+/**
+ * @brief S_Thread_StopEntStreamingSound
+ */
+static void S_Thread_StopEntStreamingSound(int entnum)
+{
+	S_LockMixer();
+	S_Base_StopEntStreamingSound(entnum);
+	S_UnlockMixer();
+}
+
+/**
+ * @brief S_Thread_FadeStreamingSound
+ */
+static void S_Thread_FadeStreamingSound(float targetVol, int time, int stream)
+{
+	S_LockMixer();
+	S_Base_FadeStreamingSound(targetVol, time, stream);
+	S_UnlockMixer();
+}
+
+/**
+ * @brief S_Thread_RawSamples
+ */
+static void S_Thread_RawSamples(int stream, int samples, int rate, int width, int channels, const byte *data, float lvol, float rvol)
+{
+	S_LockMixer();
+	S_Base_RawSamples(stream, samples, rate, width, channels, data, lvol, rvol);
+	S_UnlockMixer();
+}
+
+/**
+ * @brief S_Thread_ClearSounds
+ */
+static void S_Thread_ClearSounds(qboolean clearStreaming, qboolean clearMusic)
+{
+	S_LockMixer();
+	S_Base_ClearSounds(clearStreaming, clearMusic);
+	S_UnlockMixer();
+}
+
+/**
+ * @brief S_Thread_StopAllSounds
+ */
+static void S_Thread_StopAllSounds(void)
+{
+	S_LockMixer();
+	S_Base_StopAllSounds();
+	S_UnlockMixer();
+}
+
+/**
+ * @brief S_Thread_FadeAllSounds
+ */
+static void S_Thread_FadeAllSounds(float targetVol, int time, qboolean stopsounds)
+{
+	S_LockMixer();
+	S_Base_FadeAllSounds(targetVol, time, stopsounds);
+	S_UnlockMixer();
+}
+
+/**
+ * @brief S_Thread_DisableSounds
+ */
+static void S_Thread_DisableSounds(void)
+{
+	S_LockMixer();
+	S_Base_DisableSounds();
+	S_UnlockMixer();
+}
+
+/**
+ * @brief S_Thread_BeginRegistration
+ */
+static void S_Thread_BeginRegistration(void)
+{
+	S_LockMixer();
+	S_Base_BeginRegistration();
+	S_UnlockMixer();
+}
+
+/**
+ * @brief S_Thread_RegisterSound
+ */
+static sfxHandle_t S_Thread_RegisterSound(const char *sample, qboolean compressed)
+{
+	sfxHandle_t handle;
+
+	S_LockMixer();
+	handle = S_Base_RegisterSound(sample, compressed);
+	S_UnlockMixer();
+
+	return handle;
+}
+
+/**
+ * @brief S_Thread_ClearSoundBuffer
+ */
+static void S_Thread_ClearSoundBuffer(qboolean killStreaming)
+{
+	S_LockMixer();
+	S_Base_ClearSoundBuffer(killStreaming);
+	S_UnlockMixer();
+}
+
+/**
+ * @brief S_Thread_SoundList
+ */
+static void S_Thread_SoundList(void)
+{
+	S_LockMixer();
+	S_Base_SoundList();
+	S_UnlockMixer();
+}
+
+/**
+ * @brief S_MixerThread
+ * @param data - unused
+ * @return
+ */
+static int S_MixerThread(void *data)
+{
+	SDL_SetThreadPriority(SDL_THREAD_PRIORITY_HIGH);
+
+	while (SDL_AtomicGet(&s_mixerRunning))
+	{
+		SDL_LockMutex(s_mixerLock);
+		S_RunCommands();
+		if (!CL_VideoRecording())
+		{
+			S_Update_();
+		}
+		SDL_UnlockMutex(s_mixerLock);
+
+		SDL_Delay(SND_MIXER_MSEC);
+	}
+
+	return 0;
+}
+
+/**
+ * @brief Starts the mixer thread and routes the sound interface through it
+ * @param[in,out] si
+ */
+static void S_StartMixerThread(soundInterface_t *si)
+{
+	s_commandWrite = 0;
+	SDL_AtomicSet(&s_commandHead, 0);
+	SDL_AtomicSet(&s_commandTail, 0);
+
+	s_mixerLock = SDL_CreateMutex();
+	if (!s_mixerLock)
+	{
+		Com_Printf(S_COLOR_YELLOW "WARNING: can't create the mixer lock: %s\n", SDL_GetError());
+		return;
+	}
+
+	SDL_AtomicSet(&s_mixerRunning, 1);
+	s_mixerThreadHandle = SDL_CreateThread(S_MixerThread, "mixer", NULL);
+	if (!s_mixerThreadHandle)
+	{
+		Com_Printf(S_COLOR_YELLOW "WARNING: can't create the mixer thread: %s\n", SDL_GetError());
+		SDL_AtomicSet(&s_mixerRunning, 0);
+		SDL_DestroyMutex(s_mixerLock);
+		s_mixerLock = NULL;
+		return;
+	}
+
+	si->Reload                = S_Thread_Reload;
+	si->StartSound            = S_Thread_StartSound;
+	si->StartSoundEx          = S_Thread_StartSoundEx;
+	si->StartLocalSound       = S_Thread_StartLocalSound;
+	si->StartBackgroundTrack  = S_Thread_StartBackgroundTrack;
+	si->StopBackgroundTrack   = S_Thread_StopBackgroundTrack;
+	si->StartStreamingSound   = S_Thread_StartStreamingSound;
+	si->StopEntStreamingSound = S_Thread_StopEntStreamingSound;
+	si->FadeStreamingSound    = S_Thread_FadeStreamingSound;
+	si->RawSamples            = S_Thread_RawSamples;
+	si->ClearSounds           = S_Thread_ClearSounds;
+	si->StopAllSounds         = S_Thread_StopAllSounds;
+	si->FadeAllSounds         = S_Thread_FadeAllSounds;
+	si->ClearLoopingSounds    = S_Thread_ClearLoopingSounds;
+	si->AddLoopingSound       = S_Thread_AddLoopingSound;
+	si->AddRealLoopingSound   = S_Thread_AddRealLoopingSound;
+	si->Respatialize          = S_Thread_Respatialize;
+	si->UpdateEntityPosition  = S_Thread_UpdateEntityPosition;
+	si->Update                = S_Thread_Update;
+	si->DisableSounds         = S_Thread_DisableSounds;
+	si->BeginRegistration     = S_Thread_BeginRegistration;
+	si->RegisterSound         = S_Thread_RegisterSound;
+	si->ClearSoundBuffer      = S_Thread_ClearSoundBuffer;
+	si->SoundList             = S_Thread_SoundList;
+
+	Com_Printf("Sound mixer thread started\n");
+}
+
+/**
+ * @brief S_StopMixerThread
+ */
+static void S_StopMixerThread(void)
+{
+	if (!s_mixerLock)
+	{
+		return;
+	}
+
+	// a Com_Error may have left the lock taken
+	while (s_mixerLockDepth > 0)
+	{
+		s_mixerLockDepth--;
+		SDL_UnlockMutex(s_mixerLock);
+	}
+
+	SDL_AtomicSet(&s_mixerRunning, 0);
+	SDL_WaitThread(s_mixerThreadHandle, NULL);
+	s_mixerThreadHandle = NULL;
+
+	SDL_DestroyMutex(s_mixerLock);
+	s_mixerLock = NULL;
+}
+
 // =======================================================================
 // Shutdown sound engine
 // =======================================================================
@@ -2301,6 +3232,8 @@ void S_Base_Shutdown(void)
 		return;
 	}
 
+	S_StopMixerThread();
+
 	SNDDMA_Shutdown();
 	SND_shutdown();
 
@@ -2330,6 +3263,7 @@ qboolean S_Base_Init(soundInterface_t *si)
 	s_show         = Cvar_Get("s_show", "0", CVAR_CHEAT);
 	s_testsound    = Cvar_Get("s_testsound", "0", CVAR_CHEAT);
 	s_debugStreams = Cvar_Get("s_debugStreams", "0", CVAR_TEMP);
+	s_mixerThread  = Cvar_Get("s_mixerThread", "0", CVAR_ARCHIVE_ND | CVAR_LATCH);
 
 	r = SNDDMA_Init();
 
@@ -2389,5 +3323,10 @@ qboolean S_Base_Init(soundInterface_t *si)
 	si->MasterGain              = S_Base_MasterGain;
 #endif
 
+	if (s_mixerThread->integer)
+	{
+		S_StartMixerThread(si);
+	}
+
 	return qtrue;
 }
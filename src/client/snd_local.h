@@ -97,6 +97,8 @@ typedef struct sfx_s
 	int soundChannels;
 	char soundName[MAX_QPATH];
 	int lastTimeUsed;
+	qboolean pinned;                ///< a queued mixer thread command still needs the sound, see S_ThreadPrepareSfx
+	unsigned int pinCommand;        ///< command queue position the sound is pinned until
 	struct sfx_s *next;
 } sfx_t;
 
@@ -304,6 +306,7 @@ void SND_Com_Dealloc(sndBuffer *v);
 sndBuffer *SND_malloc(void);
 void SND_setup(void);
 void SND_shutdown(void);
+void S_FlushSoundCache(void);
 
 void S_PaintChannels(int endtime);
 
@@ -332,6 +335,7 @@ extern sfx_t *sfxScratchPointer;
 extern int   sfxScratchIndex;
 
 qboolean S_Base_Init(soundInterface_t *si);
+void S_Base_MixBench_f(void);
 
 #ifdef FEATURE_OPENAL
 
@@ -821,6 +821,9 @@ void S_Init(void)
 	s_muteWhenMinimized = Cvar_Get("s_muteWhenMinimized", "1", CVAR_ARCHIVE);
 	s_muteWhenUnfocused = Cvar_Get("s_muteWhenUnfocused", "0", CVAR_ARCHIVE);
 
+	// works without a started sound device too
+	Cmd_AddCommand("s_mixbench", S_Base_MixBench_f, "Benchmarks the sound mixer, s_mixbench [channels] [frames] [sound]");
+
 	if (!cv->integer)
 	{
 		Com_Printf("Sound disabled\n");
@@ -913,6 +916,7 @@ void S_Shutdown(void)
 	Cmd_RemoveCommand("s_list");
 	Cmd_RemoveCommand("s_stop");
 	Cmd_RemoveCommand("s_info");
+	Cmd_RemoveCommand("s_mixbench");
 
 	S_CodecShutdown();
 }
@@ -38,6 +38,44 @@
 
 #define DEF_COMSOUNDMEGS "160"
 
+#define SND_CACHE_IDENT     (('C' << 24) + ('D' << 16) + ('N' << 8) + 'S')
+#define SND_CACHE_VERSION   2
+#define SND_CACHE_MAX_FILES 8192    ///< the cache is emptied at startup when it grew larger
+
+/**
+ * @struct sndCacheHeader_t
+ * @brief Header of a decoded sound in the sound cache, followed by numSamples
+ * little endian shorts laid out like the sndBuffer chunks
+ */
+typedef struct
+{
+	int ident;
+	int version;
+	char name[MAX_QPATH];       ///< of the source file
+	int sourceLength;
+	unsigned int checksum;      ///< of the source file, or its CRC32 in the pak
+	int rate;                   ///< output rate the samples were resampled to
+	int channels;
+	int soundLength;
+	int numSamples;
+} sndCacheHeader_t;
+
+/**
+ * @struct sndCacheWrite_s
+ * @typedef sndCacheWrite_t
+ * @brief Cache entry waiting to be written once the mixer lock is released
+ */
+typedef struct sndCacheWrite_s
+{
+	char path[MAX_QPATH];
+	int size;
+	struct sndCacheWrite_s *next;
+	sndCacheHeader_t header;        ///< followed by the samples
+} sndCacheWrite_t;
+
+static cvar_t          *s_soundCache;
+static sndCacheWrite_t *s_soundCacheWrites = NULL;
+
 /*
 ===============================================================================
 memory management
@@ -83,6 +121,32 @@ redo:
 	return v;
 }
 
+/**
+ * @brief Empties the sound cache once it holds more than SND_CACHE_MAX_FILES entries
+ *
+ * Entries of sounds that were removed from the game are never read or replaced
+ * again, this bounds what they take up.
+ */
+static void S_PruneSoundCache(void)
+{
+	char **files;
+	int  numFiles, i;
+
+	files = FS_ListFiles("sound/cache", ".bin", &numFiles);
+
+	if (numFiles > SND_CACHE_MAX_FILES)
+	{
+		Com_Printf("Emptying the sound cache, %i entries\n", numFiles);
+
+		for (i = 0; i < numFiles; i++)
+		{
+			FS_HomeRemove(va("sound/cache/%s", files[i]));
+		}
+	}
+
+	FS_FreeFileList(files);
+}
+
 /**
  * @brief SND_setup
  */
@@ -92,7 +156,8 @@ void SND_setup(void)
 	cvar_t    *cv;
 	int       scs;
 
-	cv  = Cvar_Get("com_soundMegs", DEF_COMSOUNDMEGS, CVAR_LATCH | CVAR_ARCHIVE);
+	cv           = Cvar_Get("com_soundMegs", DEF_COMSOUNDMEGS, CVAR_LATCH | CVAR_ARCHIVE);
+	s_soundCache = Cvar_Get("s_soundCache", "1", CVAR_ARCHIVE_ND);
 	scs = (cv->integer * 512); // q3 uses a value of 1536 - reverted to genuine ET value
 
 	buffer = Com_Allocate(scs * sizeof(sndBuffer));
@@ -120,6 +185,11 @@ void SND_setup(void)
 	*(sndBuffer **)q = NULL;
 	freelist         = p + scs - 1;
 
+	if (s_soundCache->integer)
+	{
+		S_PruneSoundCache();
+	}
+
 	Com_Printf("Sound memory manager started\n");
 }
 
@@ -128,6 +198,8 @@ void SND_setup(void)
  */
 void SND_shutdown(void)
 {
+	S_FlushSoundCache();
+
 	Com_Dealloc(sfxScratchBuffer);
 	Com_Dealloc(buffer);
 }
@@ -231,6 +303,219 @@ static int ResampleSfxRaw(short *sfx, int channels, int inrate, int inwidth, int
 
 //=============================================================================
 
+/**
+ * @brief Case insensitive hash of a sound name for the sound cache
+ * @param[in] name
+ * @return
+ */
+static unsigned int S_SoundCacheNameHash(const char *name)
+{
+	char lower[MAX_QPATH];
+
+	Q_strncpyz(lower, name, sizeof(lower));
+	Q_strlwr(lower);
+
+	return Com_BlockChecksum(lower, strlen(lower));
+}
+
+/**
+ * @brief S_SoundCacheName
+ * @param[in] name
+ * @return path of the cached samples of a sound file at the current output rate
+ *
+ * @note A changed source file replaces its entry, the header tells whether an entry is current.
+ */
+static const char *S_SoundCacheName(const char *name)
+{
+	return va("sound/cache/%08x_%i.bin", S_SoundCacheNameHash(name), dma.speed);
+}
+
+/**
+ * @brief S_SoundFileChecksum
+ * @param[in] name
+ * @return checksum of the sound file contents, 0 if the cache is disabled or the file can't be read
+ *
+ * @note Files in paks aren't read, the CRC32 from the zip directory is used for them.
+ */
+static unsigned int S_SoundFileChecksum(const char *name)
+{
+	void         *buffer;
+	int          len;
+	unsigned int checksum;
+
+	if (!s_soundCache || !s_soundCache->integer)
+	{
+		return 0;
+	}
+
+	if (FS_FileCRC(name, &checksum))
+	{
+		return checksum;
+	}
+
+	len = FS_ReadFile(name, &buffer);
+	if (len <= 0)
+	{
+		return 0;
+	}
+
+	checksum = Com_BlockChecksum(buffer, len);
+	FS_FreeFile(buffer);
+
+	return checksum;
+}
+
+/**
+ * @brief Loads the already decoded and resampled samples of a sound from the sound cache
+ * @param[in,out] sfx
+ * @param[in] sourceLength
+ * @param[in] checksum
+ * @return qtrue if the sound was found in the cache
+ */
+static qboolean S_ReadSoundCache(sfx_t *sfx, int sourceLength, unsigned int checksum)
+{
+	sndCacheHeader_t *header;
+	short            *data;
+	sndBuffer        *chunk = NULL, *newchunk;
+	const char       *path  = S_SoundCacheName(sfx->soundName);
+	int              len, i, part, numSamples;
+
+	len = FS_ReadFile(path, (void **)&header);
+	if (len <= 0)
+	{
+		return qfalse;
+	}
+
+	numSamples = LittleLong(header->numSamples);
+
+	if (len < (int)sizeof(*header)
+	    || LittleLong(header->ident) != SND_CACHE_IDENT
+	    || LittleLong(header->version) != SND_CACHE_VERSION
+	    || Q_stricmpn(header->name, sfx->soundName, sizeof(header->name))
+	    || LittleLong(header->sourceLength) != sourceLength
+	    || (unsigned int)LittleLong(header->checksum) != checksum
+	    || LittleLong(header->rate) != dma.speed
+	    || LittleLong(header->channels) < 1 || LittleLong(header->channels) > 2
+	    || numSamples <= 0 || numSamples != LittleLong(header->soundLength) * LittleLong(header->channels)
+	    || len != (int)(sizeof(*header) + numSamples * sizeof(short)))
+	{
+		Com_DPrintf(S_COLOR_YELLOW "WARNING: removing invalid sound cache entry for %s\n", sfx->soundName);
+		FS_FreeFile(header);
+		FS_HomeRemove(path);
+		return qfalse;
+	}
+
+	sfx->lastTimeUsed           = Sys_Milliseconds() + 1;
+	sfx->soundCompressionMethod = 0;
+	sfx->soundLength            = LittleLong(header->soundLength);
+	sfx->soundChannels          = LittleLong(header->channels);
+	sfx->soundData              = NULL;
+
+	data = (short *)(header + 1);
+	for (i = 0; i < numSamples; i++)
+	{
+		part = i & (SND_CHUNK_SIZE - 1);
+		if (part == 0)
+		{
+			newchunk = SND_malloc();
+			if (chunk == NULL)
+			{
+				sfx->soundData = newchunk;
+			}
+			else
+			{
+				chunk->next = newchunk;
+			}
+			chunk = newchunk;
+		}
+
+		chunk->sndChunk[part] = LittleShort(data[i]);
+	}
+
+	FS_FreeFile(header);
+
+	return qtrue;
+}
+
+/**
+ * @brief Queues the decoded and resampled samples of a sound for the sound cache
+ * @param[in] sfx
+ * @param[in] sourceLength
+ * @param[in] checksum
+ *
+ * @note The file is written by S_FlushSoundCache, sounds are mostly loaded under
+ * the mixer lock and the mixer thread shouldn't wait for the disk.
+ */
+static void S_WriteSoundCache(const sfx_t *sfx, int sourceLength, unsigned int checksum)
+{
+	sndCacheWrite_t *write;
+	short           *data;
+	sndBuffer       *chunk     = sfx->soundData;
+	int             numSamples = sfx->soundLength * sfx->soundChannels;
+	int             size       = sizeof(sndCacheHeader_t) + numSamples * sizeof(short);
+	int             i;
+
+	if (numSamples <= 0)
+	{
+		return;
+	}
+
+	write = Com_Allocate(sizeof(*write) + numSamples * sizeof(short));
+	if (!write)
+	{
+		return;
+	}
+
+	Com_Memset(&write->header, 0, sizeof(write->header));
+	Q_strncpyz(write->header.name, sfx->soundName, sizeof(write->header.name));
+	write->header.ident        = LittleLong(SND_CACHE_IDENT);
+	write->header.version      = LittleLong(SND_CACHE_VERSION);
+	write->header.sourceLength = LittleLong(sourceLength);
+	write->header.checksum     = LittleLong(checksum);
+	write->header.rate         = LittleLong(dma.speed);
+	write->header.channels     = LittleLong(sfx->soundChannels);
+	write->header.soundLength  = LittleLong(sfx->soundLength);
+	write->header.numSamples   = LittleLong(numSamples);
+
+	data = (short *)(&write->header + 1);
+	for (i = 0; i < numSamples && chunk; i++)
+	{
+		data[i] = LittleShort(chunk->sndChunk[i & (SND_CHUNK_SIZE - 1)]);
+		if ((i & (SND_CHUNK_SIZE - 1)) == SND_CHUNK_SIZE - 1)
+		{
+			chunk = chunk->next;
+		}
+	}
+
+	if (i != numSamples)
+	{
+		Com_Dealloc(write);
+		return;
+	}
+
+	Q_strncpyz(write->path, S_SoundCacheName(sfx->soundName), sizeof(write->path));
+	write->size        = size;
+	write->next        = s_soundCacheWrites;
+	s_soundCacheWrites = write;
+}
+
+/**
+ * @brief Writes the queued sound cache entries
+ */
+void S_FlushSoundCache(void)
+{
+	sndCacheWrite_t *write, *next;
+
+	for (write = s_soundCacheWrites; write; write = next)
+	{
+		next = write->next;
+		FS_WriteFile(write->path, &write->header, write->size);
+		Com_Dealloc(write);
+	}
+
+	s_soundCacheWrites = NULL;
+}
+
 /**
  * @brief The filename may be different than sfx->name in the case
  * of a forced fallback of a player specific sound
@@ -239,9 +524,11 @@ static int ResampleSfxRaw(short *sfx, int channels, int inrate, int inwidth, int
  */
 qboolean S_LoadSound(sfx_t *sfx)
 {
-	byte       *data;
-	short      *samples;
-	snd_info_t info;
+	byte         *data;
+	short        *samples;
+	snd_info_t   info;
+	unsigned int checksum;
+	int          sourceLength;
 
 	// player specific sounds are never directly loaded
 	if (sfx->soundName[0] == '*')
@@ -249,7 +536,8 @@ qboolean S_LoadSound(sfx_t *sfx)
 		return qfalse;
 	}
 
-	if (FS_FOpenFileRead(sfx->soundName, NULL, qfalse) <= 0)
+	sourceLength = FS_FOpenFileRead(sfx->soundName, NULL, qfalse);
+	if (sourceLength <= 0)
 	{
 		if (!Q_stricmp(Cvar_VariableString("fs_game"), DEFAULT_MODGAME))
 		{
@@ -264,6 +552,13 @@ qboolean S_LoadSound(sfx_t *sfx)
 		return qfalse;
 	}
 
+	// uncompressed sounds are decoded and resampled once, then taken from the sound cache
+	checksum = sfx->soundCompressed ? 0 : S_SoundFileChecksum(sfx->soundName);
+	if (checksum && S_ReadSoundCache(sfx, sourceLength, checksum))
+	{
+		return qtrue;
+	}
+
 	// load it in
 	data = S_CodecLoad(sfx->soundName, &info);
 	if (!data)
@@ -323,6 +618,11 @@ qboolean S_LoadSound(sfx_t *sfx)
 	}
 	sfx->soundChannels = info.channels;
 
+	if (checksum && sfx->soundCompressionMethod == 0)
+	{
+		S_WriteSoundCache(sfx, sourceLength, checksum);
+	}
+
 	Hunk_FreeTempMemory(samples);
 	Hunk_FreeTempMemory(data);
 
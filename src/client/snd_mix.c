@@ -38,6 +38,11 @@
 #if idppc_altivec && !defined(__APPLE__)
 #include <altivec.h>
 #endif
+#if defined(ETL_SIMD_SSE)
+#include <emmintrin.h>
+#elif defined(ETL_SIMD_NEON)
+#include <arm_neon.h>
+#endif
 
 static portable_samplepair_t paintbuffer[PAINTBUFFER_SIZE];
 static int                   snd_vol;
@@ -48,15 +53,53 @@ short *snd_out;
 
 // #if !id386                                        // if configured not to use asm
 
+#if defined(ETL_SIMD_SSE) || defined(ETL_SIMD_NEON)
+/**
+ * @brief Clamps the paint buffer to 16 bit, 8 values a time
+ * @return number of values written
+ *
+ * @note The values are shifted down and the saturating narrow does the clamping,
+ * so the output is the same as the scalar loop.
+ */
+static ETL_SIMD_TARGET int S_WriteLinearBlastStereo16_SIMD(void)
+{
+	int i;
+
+	for (i = 0 ; i + 8 <= snd_linear_count ; i += 8)
+	{
+#ifdef ETL_SIMD_SSE
+		__m128i lo = _mm_srai_epi32(_mm_loadu_si128((const __m128i *)&snd_p[i]), 8);
+		__m128i hi = _mm_srai_epi32(_mm_loadu_si128((const __m128i *)&snd_p[i + 4]), 8);
+
+		_mm_storeu_si128((__m128i *)&snd_out[i], _mm_packs_epi32(lo, hi));
+#else
+		int32x4_t lo = vshrq_n_s32(vld1q_s32(&snd_p[i]), 8);
+		int32x4_t hi = vshrq_n_s32(vld1q_s32(&snd_p[i + 4]), 8);
+
+		vst1q_s16(&snd_out[i], vcombine_s16(vqmovn_s32(lo), vqmovn_s32(hi)));
+#endif
+	}
+
+	return i;
+}
+#endif
+
 /**
  * @brief S_WriteLinearBlastStereo16
  */
 void S_WriteLinearBlastStereo16(void)
 {
-	int i;
+	int i = 0;
 	int val;
 
-	for (i = 0 ; i < snd_linear_count ; i += 2)
+#if defined(ETL_SIMD_SSE) || defined(ETL_SIMD_NEON)
+	if (Q_SimdAvailable())
+	{
+		i = S_WriteLinearBlastStereo16_SIMD();
+	}
+#endif
+
+	for ( ; i < snd_linear_count ; i += 2)
 	{
 		val = snd_p[i] >> 8;
 		if (val > 0x7fff)
@@ -258,6 +301,126 @@ CHANNEL MIXING
 ===============================================================================
 */
 
+#if defined(ETL_SIMD_SSE) || defined(ETL_SIMD_NEON)
+/**
+ * @brief SIMD part of S_PaintSamples16, 4 sample pairs a time
+ * @param[in,out] samp
+ * @param[in] samples
+ * @param[in] count
+ * @param[in] stride
+ * @param[in] leftvol
+ * @param[in] rightvol
+ * @return number of sample pairs painted
+ */
+static ETL_SIMD_TARGET int S_PaintSamples16_SIMD(portable_samplepair_t *samp, const short *samples, int count, int stride, int leftvol, int rightvol)
+{
+	int i;
+
+#ifdef ETL_SIMD_SSE
+	// (data * vol) >> 8 == data * (vol >> 8) + ((data * (vol & 0xff)) >> 8), both products
+	// fit pmaddwd so the result is bit exact with the scalar code for volumes up to 0xffff
+	const __m128i volLo = _mm_set_epi32(rightvol & 0xff, leftvol & 0xff, rightvol & 0xff, leftvol & 0xff);
+	const __m128i volHi = _mm_set_epi32(rightvol >> 8, leftvol >> 8, rightvol >> 8, leftvol >> 8);
+	__m128i       src, a, b;
+	__m128i       *dst;
+
+	if ((unsigned int)leftvol > 0xffff || (unsigned int)rightvol > 0xffff)
+	{
+		return 0;
+	}
+
+	for (i = 0 ; i + 4 <= count ; i += 4)
+	{
+		if (stride == 2)
+		{
+			src = _mm_loadu_si128((const __m128i *)&samples[i * 2]);
+			a   = _mm_unpacklo_epi16(src, src);  // L0 R0 L1 R1
+			b   = _mm_unpackhi_epi16(src, src);  // L2 R2 L3 R3
+		}
+		else
+		{
+			src = _mm_loadl_epi64((const __m128i *)&samples[i]);
+			src = _mm_unpacklo_epi16(src, src);
+			a   = _mm_unpacklo_epi32(src, src);  // d0 d0 d1 d1
+			b   = _mm_unpackhi_epi32(src, src);  // d2 d2 d3 d3
+		}
+
+		a = _mm_add_epi32(_mm_srai_epi32(_mm_madd_epi16(a, volLo), 8), _mm_madd_epi16(a, volHi));
+		b = _mm_add_epi32(_mm_srai_epi32(_mm_madd_epi16(b, volLo), 8), _mm_madd_epi16(b, volHi));
+
+		dst = (__m128i *)&samp[i];
+		_mm_storeu_si128(dst, _mm_add_epi32(_mm_loadu_si128(dst), a));
+		_mm_storeu_si128(dst + 1, _mm_add_epi32(_mm_loadu_si128(dst + 1), b));
+	}
+#else
+	// NEON has a full 32 bit multiply, the products are the same as the scalar code
+	// as long as they don't overflow, which the volume limit guarantees
+	const int32x2_t volLR = vset_lane_s32(rightvol, vdup_n_s32(leftvol), 1);
+	const int32x4_t vol   = vcombine_s32(volLR, volLR);
+	int16x4x2_t     src;
+	int32x4_t       a, b;
+	int32_t         *dst;
+
+	if ((unsigned int)leftvol > 0xffff || (unsigned int)rightvol > 0xffff)
+	{
+		return 0;
+	}
+
+	for (i = 0 ; i + 4 <= count ; i += 4)
+	{
+		if (stride == 2)
+		{
+			int16x8_t lr = vld1q_s16(&samples[i * 2]);
+
+			a = vmovl_s16(vget_low_s16(lr));     // L0 R0 L1 R1
+			b = vmovl_s16(vget_high_s16(lr));    // L2 R2 L3 R3
+		}
+		else
+		{
+			int16x4_t d = vld1_s16(&samples[i]);
+
+			src = vzip_s16(d, d);
+			a   = vmovl_s16(src.val[0]);         // d0 d0 d1 d1
+			b   = vmovl_s16(src.val[1]);         // d2 d2 d3 d3
+		}
+
+		dst = (int32_t *)&samp[i];
+		vst1q_s32(dst, vaddq_s32(vld1q_s32(dst), vshrq_n_s32(vmulq_s32(a, vol), 8)));
+		vst1q_s32(dst + 4, vaddq_s32(vld1q_s32(dst + 4), vshrq_n_s32(vmulq_s32(b, vol), 8)));
+	}
+#endif
+
+	return i;
+}
+#endif
+
+/**
+ * @brief Adds a run of 16 bit samples scaled by the channel volumes to the paint buffer
+ * @param[in,out] samp
+ * @param[in] samples
+ * @param[in] count number of sample pairs to paint
+ * @param[in] stride 1 for mono, 2 for interleaved stereo source data
+ * @param[in] leftvol
+ * @param[in] rightvol
+ */
+static void S_PaintSamples16(portable_samplepair_t *samp, const short *samples, int count, int stride, int leftvol, int rightvol)
+{
+	int i = 0;
+
+#if defined(ETL_SIMD_SSE) || defined(ETL_SIMD_NEON)
+	if (Q_SimdAvailable())
+	{
+		i = S_PaintSamples16_SIMD(samp, samples, count, stride, leftvol, rightvol);
+	}
+#endif
+
+	for ( ; i < count ; i++)
+	{
+		samp[i].left  += (samples[i * stride] * leftvol) >> 8;
+		samp[i].right += (samples[i * stride + stride - 1] * rightvol) >> 8;
+	}
+}
+
 #if idppc_altivec
 /**
  * @brief S_PaintChannelFrom16_altivec
@@ -488,7 +651,7 @@ static void S_PaintChannelFrom16_altivec(channel_t *ch, const sfx_t *sc, int cou
  */
 static void S_PaintChannelFrom16_scalar(channel_t *ch, const sfx_t *sc, int count, int sampleOffset, int bufferOffset)
 {
-	int                   data, aoff, boff;
+	int                   aoff, boff, run;
 	int                   leftvol, rightvol;
 	int                   i, j;
 	portable_samplepair_t *samp  = &paintbuffer[bufferOffset];
@@ -531,17 +694,20 @@ static void S_PaintChannelFrom16_scalar(channel_t *ch, const sfx_t *sc, int coun
 		leftvol  = ch->leftvol * snd_vol;
 		rightvol = ch->rightvol * snd_vol;
 		samples  = chunk->sndChunk;
-		for (i = 0 ; i < count ; i++)
+
+		// paint up to the end of each chunk in one go
+		for (i = 0 ; i < count ; i += run)
 		{
-			data          = samples[sampleOffset++];
-			samp[i].left += (data * leftvol) >> 8;
-			if (sc->soundChannels == 2 && sampleOffset < SND_CHUNK_SIZE)
+			run = (SND_CHUNK_SIZE - sampleOffset) / sc->soundChannels;
+			if (run > count - i)
 			{
-				data = samples[sampleOffset++];
+				run = count - i;
 			}
-			samp[i].right += (data * rightvol) >> 8;
 
-			if (sampleOffset == SND_CHUNK_SIZE)
+			S_PaintSamples16(&samp[i], &samples[sampleOffset], run, sc->soundChannels, leftvol, rightvol);
+			sampleOffset += run * sc->soundChannels;
+
+			if (sampleOffset == SND_CHUNK_SIZE && i + run < count)
 			{
 				chunk        = chunk->next;
 				samples      = chunk->sndChunk;
@@ -626,7 +792,7 @@ void S_PaintChannelFromWavelet(channel_t *ch, sfx_t *sc, int count, int sampleOf
 {
 	int                   leftvol  = ch->leftvol * snd_vol;
 	int                   rightvol = ch->rightvol * snd_vol;
-	int                   data;
+	int                   run;
 	int                   i      = 0;
 	portable_samplepair_t *samp  = &paintbuffer[bufferOffset];
 	sndBuffer             *chunk = sc->soundData;
@@ -648,11 +814,16 @@ void S_PaintChannelFromWavelet(channel_t *ch, sfx_t *sc, int count, int sampleOf
 
 	samples = sfxScratchBuffer;
 
-	for (i = 0 ; i < count ; i++)
+	for (i = 0 ; i < count ; i += run)
 	{
-		data           = samples[sampleOffset++];
-		samp[i].left  += (data * leftvol) >> 8;
-		samp[i].right += (data * rightvol) >> 8;
+		run = SND_CHUNK_SIZE * 2 - sampleOffset;
+		if (run > count - i)
+		{
+			run = count - i;
+		}
+
+		S_PaintSamples16(&samp[i], &samples[sampleOffset], run, 1, leftvol, rightvol);
+		sampleOffset += run;
 
 		if (sampleOffset == SND_CHUNK_SIZE * 2)
 		{
@@ -674,7 +845,7 @@ void S_PaintChannelFromWavelet(channel_t *ch, sfx_t *sc, int count, int sampleOf
  */
 void S_PaintChannelFromADPCM(channel_t *ch, sfx_t *sc, int count, int sampleOffset, int bufferOffset)
 {
-	int                   data;
+	int                   run;
 	int                   leftvol  = ch->leftvol * snd_vol;
 	int                   rightvol = ch->rightvol * snd_vol;
 	int                   i        = 0;
@@ -703,11 +874,16 @@ void S_PaintChannelFromADPCM(channel_t *ch, sfx_t *sc, int count, int sampleOffs
 
 	samples = sfxScratchBuffer;
 
-	for (i = 0 ; i < count ; i++)
+	for (i = 0 ; i < count ; i += run)
 	{
-		data           = samples[sampleOffset++];
-		samp[i].left  += (data * leftvol) >> 8;
-		samp[i].right += (data * rightvol) >> 8;
+		run = SND_CHUNK_SIZE * 4 - sampleOffset;
+		if (run > count - i)
+		{
+			run = count - i;
+		}
+
+		S_PaintSamples16(&samp[i], &samples[sampleOffset], run, 1, leftvol, rightvol);
+		sampleOffset += run;
 
 		if (sampleOffset == SND_CHUNK_SIZE * 4)
 		{
@@ -730,10 +906,11 @@ void S_PaintChannelFromADPCM(channel_t *ch, sfx_t *sc, int count, int sampleOffs
 void S_PaintChannelFromMuLaw(channel_t *ch, sfx_t *sc, int count, int sampleOffset, int bufferOffset)
 {
 	float                 ooff;
-	int                   data;
+	int                   data, run;
 	int                   leftvol  = ch->leftvol * snd_vol;
 	int                   rightvol = ch->rightvol * snd_vol;
-	int                   i;
+	int                   i, j;
+	short                 decoded[256];
 	portable_samplepair_t *samp  = &paintbuffer[bufferOffset];
 	sndBuffer             *chunk = sc->soundData;
 	byte                  *samples;
@@ -750,14 +927,29 @@ void S_PaintChannelFromMuLaw(channel_t *ch, sfx_t *sc, int count, int sampleOffs
 
 	if (!ch->doppler)
 	{
+		// decode a run into a small buffer and paint it like 16 bit data
 		samples = (byte *)chunk->sndChunk + sampleOffset;
-		for (i = 0 ; i < count ; i++)
+		for (i = 0 ; i < count ; i += run)
 		{
-			data           = mulawToShort[*samples];
-			samp[i].left  += (data * leftvol) >> 8;
-			samp[i].right += (data * rightvol) >> 8;
-			samples++;
-			if (samples == (byte *)chunk->sndChunk + (SND_CHUNK_SIZE * 2))
+			run = (byte *)chunk->sndChunk + (SND_CHUNK_SIZE * 2) - samples;
+			if (run > count - i)
+			{
+				run = count - i;
+			}
+			if (run > (int)ARRAY_LEN(decoded))
+			{
+				run = ARRAY_LEN(decoded);
+			}
+
+			for (j = 0 ; j < run ; j++)
+			{
+				decoded[j] = mulawToShort[samples[j]];
+			}
+
+			S_PaintSamples16(&samp[i], decoded, run, 1, leftvol, rightvol);
+			samples += run;
+
+			if (samples == (byte *)chunk->sndChunk + (SND_CHUNK_SIZE * 2) && i + run < count)
 			{
 				chunk   = chunk->next;
 				samples = (byte *)chunk->sndChunk;
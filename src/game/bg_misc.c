@@ -4988,3 +4988,58 @@ void BG_LegsCollisionBoxOffset(vec3_t viewangles, int eFlags, vec3_t legsOffset)
 		VectorScale(flatforward, -32, legsOffset);
 	}
 }
+
+/**
+ * @brief Remembers which cvar table entry a registered cvar belongs to
+ * @param[in,out] cvarChanges
+ * @param[in] tableIndex
+ * @param[in] vmCvar registered cvar, NULL for table entries without one
+ */
+void BG_CvarChangesRegister(bgCvarChanges_t *cvarChanges, int tableIndex, const vmCvar_t *vmCvar)
+{
+	if (!vmCvar || (unsigned)vmCvar->handle >= MAX_CVARS)
+	{
+		return;
+	}
+
+	cvarChanges->tableIndex[vmCvar->handle] = (short)(tableIndex + 1);
+}
+
+/**
+ * @brief Collects the cvar table entries which have to be updated this frame
+ *
+ * Engines supporting the change notification extension report only the cvars
+ * which were modified, on all others every table entry has to be polled.
+ *
+ * @param[in] cvarChanges
+ * @param[out] tableIndexes cvar table indexes to update, has to hold tableSize entries
+ * @param[in] tableSize number of entries in the cvar table
+ * @return number of table indexes
+ */
+int BG_CvarChangesGet(bgCvarChanges_t *cvarChanges, int *tableIndexes, int tableSize)
+{
+	cvarHandle_t handles[MAX_CVAR_CHANGES];
+	int          numHandles, numIndexes = 0, i;
+
+	numHandles = trap_Cvar_GetChanges(handles, MAX_CVAR_CHANGES);
+
+	if (numHandles < 0)
+	{
+		for (i = 0; i < tableSize; i++)
+		{
+			tableIndexes[i] = i;
+		}
+
+		return tableSize;
+	}
+
+	for (i = 0; i < numHandles && numIndexes < tableSize; i++)
+	{
+		if ((unsigned)handles[i] < MAX_CVARS && cvarChanges->tableIndex[handles[i]])
+		{
+			tableIndexes[numIndexes++] = cvarChanges->tableIndex[handles[i]] - 1;
+		}
+	}
+
+	return numIndexes;
+}
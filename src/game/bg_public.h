@@ -2782,6 +2782,21 @@ int trap_PC_ReadToken(int handle, pc_token_t *pc_token);
 int trap_PC_SourceFileAndLine(int handle, char *filename, int *line);
 int trap_PC_UnReadToken(int handle);
 
+int trap_Cvar_GetChanges(cvarHandle_t *handles, int maxHandles);
+
+/**
+ * @struct bgCvarChanges_s
+ * @typedef bgCvarChanges_t
+ * @brief Maps the cvar handles the engine reports as changed back to the cvar table of a module
+ */
+typedef struct bgCvarChanges_s
+{
+	short tableIndex[MAX_CVARS];    ///< cvar table index + 1 of each registered handle, 0 if not in the table
+} bgCvarChanges_t;
+
+void BG_CvarChangesRegister(bgCvarChanges_t *cvarChanges, int tableIndex, const vmCvar_t *vmCvar);
+int BG_CvarChangesGet(bgCvarChanges_t *cvarChanges, int *tableIndexes, int tableSize);
+
 void PC_SourceError(int handle, const char *format, ...);
 //void PC_SourceWarning(int handle, const char *format, ...); // Unused
 
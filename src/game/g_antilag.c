@@ -177,6 +177,36 @@ void G_StoreClientPosition(gentity_t *ent)
 	ent->client->clientMarkers[top].legsPitching      = ent->legsFrame.pitching;
 }
 
+/**
+ * @brief Find a pair of markers which bound the requested time
+ * @param[in] client client which markers to search
+ * @param[in] time timestamp which to use
+ * @param[out] i index of the marker at or before "time"
+ * @param[out] j index of the marker after "time"
+ * @return false if there are no valid stored markers
+ */
+static qboolean G_FindClientMarkers(gclient_t *client, int time, int *i, int *j)
+{
+	*i = *j = client->topMarker;
+	do
+	{
+		if (client->clientMarkers[*i].time <= time)
+		{
+			break;
+		}
+
+		*j = *i;
+		(*i)--;
+		if (*i < 0)
+		{
+			*i = MAX_CLIENT_MARKERS - 1;
+		}
+	}
+	while (*i != client->topMarker);
+
+	return *i != *j;
+}
+
 /**
  * @brief Move a client back to where he was at the specified "time"
  * @param[in,out] ent client entity which to shift
@@ -197,25 +227,7 @@ static qboolean G_AdjustSingleClientPosition(gentity_t *ent, int time)
 		return qfalse;
 	}
 
-	// find a pair of markers which bound the requested time
-	i = j = ent->client->topMarker;
-	do
-	{
-		if (ent->client->clientMarkers[i].time <= time)
-		{
-			break;
-		}
-
-		j = i;
-		i--;
-		if (i < 0)
-		{
-			i = MAX_CLIENT_MARKERS - 1;
-		}
-	}
-	while (i != ent->client->topMarker);
-
-	if (i == j)     // oops, no valid stored markers
+	if (!G_FindClientMarkers(ent->client, time, &i, &j))
 	{
 		return qfalse;
 	}
@@ -497,6 +509,170 @@ qboolean G_ReAdjustSingleClientPosition(gentity_t *ent)
 	return qfalse;
 }
 
+// head and prone/dead leg boxes are built around the client origin
+// and reach out of its bounding box, keep some room for them
+#define ANTILAG_CULL_PADDING 48.f
+
+static int antilagRewinds;
+static int antilagRewindsAvoided;
+
+/**
+ * @brief Test a (swept box) ray against an axis aligned box using slabs
+ * @param[in] start
+ * @param[in] end
+ * @param[in] mins
+ * @param[in] maxs
+ * @return true if the segment from start to end touches the box
+ */
+static qboolean G_AntilagRayHitsBounds(const vec3_t start, const vec3_t end, const vec3_t mins, const vec3_t maxs)
+{
+	float tmin = 0.f, tmax = 1.f;
+	float delta, t1, t2, tmp;
+	int   k;
+
+	for (k = 0; k < 3; k++)
+	{
+		delta = end[k] - start[k];
+
+		if (delta == 0.f)
+		{
+			if (start[k] < mins[k] || start[k] > maxs[k])
+			{
+				return qfalse;
+			}
+			continue;
+		}
+
+		t1 = (mins[k] - start[k]) / delta;
+		t2 = (maxs[k] - start[k]) / delta;
+		if (t1 > t2)
+		{
+			tmp = t1;
+			t1  = t2;
+			t2  = tmp;
+		}
+
+		if (t1 > tmin)
+		{
+			tmin = t1;
+		}
+		if (t2 < tmax)
+		{
+			tmax = t2;
+		}
+		if (tmin > tmax)
+		{
+			return qfalse;
+		}
+	}
+
+	return qtrue;
+}
+
+/**
+ * @brief Check if a client shifted back to "time" could be touched by the trace
+ *
+ * The bounds tested are the union of the two markers the client would be
+ * interpolated between, and the current bounds of the client. Only a miss of
+ * both means the rewind can't change the result: a client left in place could
+ * otherwise be hit where the shooter never saw it.
+ *
+ * @param[in] ent client entity which would be shifted
+ * @param[in] time timestamp which to use
+ * @param[in] start
+ * @param[in] mins
+ * @param[in] maxs
+ * @param[in] end
+ * @return false if the rewind can be skipped
+ */
+static qboolean G_AntilagCandidate(gentity_t *ent, int time, const vec3_t start, const vec3_t mins, const vec3_t maxs, const vec3_t end)
+{
+	clientMarker_t *mi, *mj;
+	vec3_t         absmin, absmax, curmin, curmax;
+	int            i, j, k;
+
+	if (time > level.time)
+	{
+		time = level.time;
+	}
+
+	// not shifted at all, nothing to save
+	if (!G_AntilagSafe(ent) || !G_FindClientMarkers(ent->client, time, &i, &j))
+	{
+		return qtrue;
+	}
+
+	mj = &ent->client->clientMarkers[j];
+	mi = (i != ent->client->topMarker) ? &ent->client->clientMarkers[i] : mj;
+
+	for (k = 0; k < 3; k++)
+	{
+		absmin[k] = MIN(mi->origin[k] + mi->mins[k], mj->origin[k] + mj->mins[k]) - ANTILAG_CULL_PADDING;
+		absmax[k] = MAX(mi->origin[k] + mi->maxs[k], mj->origin[k] + mj->maxs[k]) + ANTILAG_CULL_PADDING;
+		curmin[k] = ent->r.currentOrigin[k] + ent->r.mins[k] - ANTILAG_CULL_PADDING;
+		curmax[k] = ent->r.currentOrigin[k] + ent->r.maxs[k] + ANTILAG_CULL_PADDING;
+
+		// grow by the trace box so the swept box becomes a ray
+		if (mins && maxs)
+		{
+			absmin[k] -= maxs[k];
+			absmax[k] -= mins[k];
+			curmin[k] -= maxs[k];
+			curmax[k] -= mins[k];
+		}
+	}
+
+	return G_AntilagRayHitsBounds(start, end, absmin, absmax) || G_AntilagRayHitsBounds(start, end, curmin, curmax);
+}
+
+/**
+ * @brief Move the clients which could be touched by the trace back to where they were at the specified "time"
+ * @param[in] skip Client to skip (the one shooting currently)
+ * @param[in] time timestamp which to use
+ * @param[in] start
+ * @param[in] mins
+ * @param[in] maxs
+ * @param[in] end
+ */
+static void G_AdjustClientPositionsForTrace(gentity_t *skip, int time, const vec3_t start, const vec3_t mins, const vec3_t maxs, const vec3_t end)
+{
+	int       i;
+	gentity_t *list;
+
+	for (i = 0; i < level.numConnectedClients; i++)
+	{
+		list = g_entities + level.sortedClients[i];
+
+		// dont adjust the firing client entity
+		if (list == skip)
+		{
+			continue;
+		}
+
+		if (!G_AntilagCandidate(list, time, start, mins, maxs, end))
+		{
+			antilagRewindsAvoided++;
+			continue;
+		}
+
+		if (G_AdjustSingleClientPosition(list, time))
+		{
+			antilagRewinds++;
+		}
+	}
+}
+
+/**
+ * @brief Print and reset the antilag rewind counters
+ */
+void Svcmd_AntilagStats_f(void)
+{
+	G_Printf("Antilag: %i client rewinds - %i rewinds avoided\n", antilagRewinds, antilagRewindsAvoided);
+
+	antilagRewinds        = 0;
+	antilagRewindsAvoided = 0;
+}
+
 /**
  * @brief Move ALL clients back to where they were at the specified "time", except for "skip"
  * @param[in] skip Client to skip (the one shooting currently)
@@ -698,7 +874,7 @@ void G_HistoricalTrace(gentity_t *ent, trace_t *results, const vec3_t start, con
 		return;
 	}
 
-	G_AdjustClientPositions(ent, ent->client->pers.cmd.serverTime, qtrue);
+	G_AdjustClientPositionsForTrace(ent, ent->client->pers.cmd.serverTime, start, mins, maxs, end);
 
 	G_Trace(ent, results, start, mins, maxs, end, passEntityNum, contentmask);
 
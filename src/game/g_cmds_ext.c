@@ -72,7 +72,6 @@ typedef struct
 // VC optimizes for dup strings :)
 static const cmd_reference_t aCommandInfo[] =
 {
-	// keep "say" command on top for optimisation purpose, they are the most used command
 	{ "say",            CMD_USAGE_ANY_TIME,          qtrue,       qtrue,  G_say_cmd,                           " <msg>:^7 Sends a chat message"                                                             },
 	{ "say_team",       CMD_USAGE_ANY_TIME,          qtrue,       qtrue,  G_say_team_cmd,                      " <msg>:^7 Sends a team chat message"                                                        },
 	{ "say_buddy",      CMD_USAGE_ANY_TIME,          qtrue,       qtrue,  G_say_buddy_cmd,                     " <msg>:^7 Sends a buddy chat message"                                                       },
@@ -180,6 +179,52 @@ static const cmd_reference_t aCommandInfo[] =
 	{ NULL,             CMD_USAGE_ANY_TIME,          qtrue,       qfalse, NULL,                                ""                                                                                           }
 };
 
+#define CMD_HASH_SIZE 256
+
+static int      cmdHashTable[CMD_HASH_SIZE];          ///< aCommandInfo index + 1 of the first command in a bucket
+static int      cmdHashNext[ARRAY_LEN(aCommandInfo)]; ///< aCommandInfo index + 1 of the next command in the same bucket
+static qboolean cmdHashInitialized = qfalse;
+
+/**
+ * @brief Finds a client command by case insensitive name
+ * @param[in] cmd
+ * @return index into aCommandInfo or -1 if the command doesn't exist or has no handler
+ */
+static int G_commandFind(const char *cmd)
+{
+	int i;
+
+	// aCommandInfo is fixed at build time, hash it once on first use
+	if (!cmdHashInitialized)
+	{
+		long hash;
+
+		for (i = 0; aCommandInfo[i].pszCommandName; i++)
+		{
+			if (!aCommandInfo[i].pCommand)
+			{
+				continue;
+			}
+
+			hash               = Q_GenerateHashValue(aCommandInfo[i].pszCommandName, CMD_HASH_SIZE, qtrue, qtrue);
+			cmdHashNext[i]     = cmdHashTable[hash];
+			cmdHashTable[hash] = i + 1;
+		}
+
+		cmdHashInitialized = qtrue;
+	}
+
+	for (i = cmdHashTable[Q_GenerateHashValue(cmd, CMD_HASH_SIZE, qtrue, qtrue)] - 1; i >= 0; i = cmdHashNext[i] - 1)
+	{
+		if (!Q_stricmp(cmd, aCommandInfo[i].pszCommandName))
+		{
+			return i;
+		}
+	}
+
+	return -1;
+}
+
 /**
  * @brief G_ClientIsFlooding
  * @param[in] ent
@@ -227,41 +272,37 @@ qboolean G_ClientIsFlooding(gentity_t *ent)
  */
 qboolean G_commandCheck(gentity_t *ent, const char *cmd)
 {
-	unsigned int i;
+	int i = G_commandFind(cmd);
 
-	for (i = 0; aCommandInfo[i].pszCommandName; i++)
+	if (i < 0)
 	{
-		if (aCommandInfo[i].pCommand && 0 == Q_stricmp(cmd, aCommandInfo[i].pszCommandName))
-		{
-			// check for flood protected commands
-			if (aCommandInfo[i].floodProtected && G_ClientIsFlooding(ent))
-			{
-				CPx(ent->s.clientNum, va("print \"^1Flood protection: ^7command ^3%s ^7ignored.\n\"", cmd));
-				return qfalse;
-			}
-			// ignore some commands when at intermission
-			if (level.intermissiontime && (aCommandInfo[i].flag & CMD_USAGE_NO_INTERMISSION))
-			{
-				CPx(ent->s.clientNum, va("print \"^3%s^7 not allowed during intermission.\n\"", cmd));
-				return qfalse;
-			}
-
-			// ignore some commands when not at intermission
-			if (!level.intermissiontime && (aCommandInfo[i].flag & CMD_USAGE_INTERMISSION_ONLY))
-			{
-				CPx(ent->s.clientNum, va("print \"^3%s^7 not allowed outside intermission.\n\"", cmd));
-				return qfalse;
-			}
+		trap_SendServerCommand(ent->s.clientNum, va("print \"unknown cmd[lof] %s\n\"", cmd));
+		return qfalse;
+	}
 
-			aCommandInfo[i].pCommand(ent, i, aCommandInfo[i].value);
+	// check for flood protected commands
+	if (aCommandInfo[i].floodProtected && G_ClientIsFlooding(ent))
+	{
+		CPx(ent->s.clientNum, va("print \"^1Flood protection: ^7command ^3%s ^7ignored.\n\"", cmd));
+		return qfalse;
+	}
+	// ignore some commands when at intermission
+	if (level.intermissiontime && (aCommandInfo[i].flag & CMD_USAGE_NO_INTERMISSION))
+	{
+		CPx(ent->s.clientNum, va("print \"^3%s^7 not allowed during intermission.\n\"", cmd));
+		return qfalse;
+	}
 
-			return qtrue;
-		}
+	// ignore some commands when not at intermission
+	if (!level.intermissiontime && (aCommandInfo[i].flag & CMD_USAGE_INTERMISSION_ONLY))
+	{
+		CPx(ent->s.clientNum, va("print \"^3%s^7 not allowed outside intermission.\n\"", cmd));
+		return qfalse;
 	}
 
-	trap_SendServerCommand(ent->s.clientNum, va("print \"unknown cmd[lof] %s\n\"", cmd));
+	aCommandInfo[i].pCommand(ent, i, aCommandInfo[i].value);
 
-	return qfalse;
+	return qtrue;
 }
 
 /**
@@ -336,13 +377,11 @@ void G_commands_cmd(gentity_t *ent, unsigned int dwCommand, int value)
 		char arg[MAX_TOKEN_CHARS];
 		trap_Argv(1, arg, sizeof(arg));
 
-		for (i = 0; aCommandInfo[i].pszCommandName; i++)
+		i = G_commandFind(arg);
+		if (i >= 0)
 		{
-			if (aCommandInfo[i].pCommand && !Q_stricmp(arg, aCommandInfo[i].pszCommandName))
-			{
-				G_commandHelp(ent, arg, i);
-				return;
-			}
+			G_commandHelp(ent, arg, i);
+			return;
 		}
 	}
 
@@ -2079,6 +2079,7 @@ extern vmCvar_t g_maxWarp;
 #ifdef FEATURE_LUA
 extern vmCvar_t lua_modules;
 extern vmCvar_t lua_allowedModules;
+extern vmCvar_t lua_maxInstructions;
 #endif
 
 extern vmCvar_t g_guidCheck;
@@ -2220,6 +2221,7 @@ int trap_FS_GetFileList(const char *path, const char *extension, char *listbuf,
 void trap_SendConsoleCommand(int exec_when, const char *text);
 void trap_Cvar_Register(vmCvar_t *vmCvar, const char *varName, const char *defaultValue, int flags);
 void trap_Cvar_Update(vmCvar_t *vmCvar);
+void G_InitExtensionTraps(void);
 void trap_Cvar_Set(const char *varName, const char *value);
 int trap_Cvar_VariableIntegerValue(const char *varName);
 float trap_Cvar_VariableValue(const char *varName);
@@ -2286,6 +2288,7 @@ void G_HistoricalTraceBegin(gentity_t *ent);
 void G_HistoricalTraceEnd(gentity_t *ent);
 void G_Trace(gentity_t *ent, trace_t *results, const vec3_t start, const vec3_t mins, const vec3_t maxs, const vec3_t end, int passEntityNum, int contentmask);
 void G_PredictPmove(gentity_t *ent, float frametime);
+void Svcmd_AntilagStats_f(void);
 
 #define BODY_VALUE(ENT) ENT->watertype
 #define BODY_TEAM(ENT) ENT->s.modelindex
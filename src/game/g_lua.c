@@ -25,6 +25,42 @@ extern field_t fields[];
 
 lua_vm_t *lVM[LUA_NUM_VM];
 
+/**
+ * @var luaHookVMs
+ * @brief Bit set per VM id implementing the callback, undefined callbacks are skipped without touching any VM
+ */
+int luaHookVMs[LUA_NUM_HOOKS];
+
+/**
+ * @var luaHookNames
+ * @brief Global function names of the callbacks, indexed by luaHook_t
+ */
+static const char *luaHookNames[LUA_NUM_HOOKS] =
+{
+	"et_InitGame",
+	"et_ShutdownGame",
+	"et_RunFrame",
+	"et_ClientConnect",
+	"et_ClientDisconnect",
+	"et_ClientBegin",
+	"et_ClientUserinfoChanged",
+	"et_ClientSpawn",
+	"et_ClientCommand",
+	"et_ConsoleCommand",
+	"et_UpgradeSkill",
+	"et_SetPlayerSkill",
+	"et_Print",
+	"et_DPrint",
+	"et_Error",
+	"et_Obituary",
+	"et_Damage",
+	"et_WeaponFire",
+	"et_FixedMGFire",
+	"et_MountedMGFire",
+	"et_AAGunFire",
+	"et_SpawnEntitiesFromString",
+};
+
 /**
  * @param addr pointer to a gentity (gentity*)
  * @returns the entity number.
@@ -1188,34 +1224,122 @@ static const gentity_field_t gentity_fields[] =
 	{ NULL },
 };
 
+#define FIELD_HASH_SIZE 512
+
+static int      gclientFieldHash[FIELD_HASH_SIZE];          ///< gclient_fields index + 1 of the first field in a bucket
+static int      gclientFieldNext[ARRAY_LEN(gclient_fields)]; ///< gclient_fields index + 1 of the next field in the same bucket
+static int      gentityFieldHash[FIELD_HASH_SIZE];          ///< gentity_fields index + 1 of the first field in a bucket
+static int      gentityFieldNext[ARRAY_LEN(gentity_fields)]; ///< gentity_fields index + 1 of the next field in the same bucket
+static qboolean fieldHashInitialized = qfalse;
+
+// field handles returned by et.gentity_field() keep both table indexes,
+// a name can be a client field alias of an entity field (e.g. origin)
+#define FIELD_HANDLE(clientIndex, entityIndex) ((((clientIndex) + 1) << 16) | ((entityIndex) + 1))
+#define FIELD_HANDLE_GCLIENT(handle) ((((handle) >> 16) & 0xFFFF) - 1)
+#define FIELD_HANDLE_GENTITY(handle) (((handle) & 0xFFFF) - 1)
+
 // gentity fields helper functions
-static gentity_field_t *_et_gentity_getfield(gentity_t *ent, char *fieldname)
+static void _et_gentity_hashfields(void)
 {
-	int i;
+	int  i;
+	long hash;
+
+	for (i = 0; gclient_fields[i].name; i++)
+	{
+		hash                   = Q_GenerateHashValue(gclient_fields[i].name, FIELD_HASH_SIZE, qtrue, qtrue);
+		gclientFieldNext[i]    = gclientFieldHash[hash];
+		gclientFieldHash[hash] = i + 1;
+	}
+
+	for (i = 0; gentity_fields[i].name; i++)
+	{
+		hash                   = Q_GenerateHashValue(gentity_fields[i].name, FIELD_HASH_SIZE, qtrue, qtrue);
+		gentityFieldNext[i]    = gentityFieldHash[hash];
+		gentityFieldHash[hash] = i + 1;
+	}
+
+	fieldHashInitialized = qtrue;
+}
+
+// returns the gclient_fields and gentity_fields indexes of a field name, -1 if not found
+static void _et_gentity_findfield(const char *fieldname, int *clientIndex, int *entityIndex)
+{
+	long hash;
+	int  i;
+
+	// the field tables are fixed at build time, hash them once on first use
+	if (!fieldHashInitialized)
+	{
+		_et_gentity_hashfields();
+	}
 
-	// search through client fields first
-	if (ent->client)
+	hash         = Q_GenerateHashValue(fieldname, FIELD_HASH_SIZE, qtrue, qtrue);
+	*clientIndex = -1;
+	*entityIndex = -1;
+
+	for (i = gclientFieldHash[hash] - 1; i >= 0; i = gclientFieldNext[i] - 1)
 	{
-		for (i = 0; gclient_fields[i].name; i++)
+		if (Q_stricmp(fieldname, gclient_fields[i].name) == 0)
 		{
-			if (Q_stricmp(fieldname, gclient_fields[i].name) == 0)
-			{
-				return (gentity_field_t *)&gclient_fields[i];
-			}
+			*clientIndex = i;
+			break;
 		}
 	}
 
-	for (i = 0; gentity_fields[i].name; i++)
+	for (i = gentityFieldHash[hash] - 1; i >= 0; i = gentityFieldNext[i] - 1)
 	{
 		if (Q_stricmp(fieldname, gentity_fields[i].name) == 0)
 		{
-			return (gentity_field_t *)&gentity_fields[i];
+			*entityIndex = i;
+			break;
 		}
 	}
+}
+
+// client fields take precedence over entity fields for client entities
+static gentity_field_t *_et_gentity_fieldbyindex(gentity_t *ent, int clientIndex, int entityIndex)
+{
+	if (ent->client && clientIndex >= 0 && clientIndex < ARRAY_LEN(gclient_fields) - 1)
+	{
+		return (gentity_field_t *)&gclient_fields[clientIndex];
+	}
+
+	if (entityIndex >= 0 && entityIndex < ARRAY_LEN(gentity_fields) - 1)
+	{
+		return (gentity_field_t *)&gentity_fields[entityIndex];
+	}
 
 	return 0;
 }
 
+static gentity_field_t *_et_gentity_getfield(gentity_t *ent, char *fieldname)
+{
+	int clientIndex, entityIndex;
+
+	_et_gentity_findfield(fieldname, &clientIndex, &entityIndex);
+
+	return _et_gentity_fieldbyindex(ent, clientIndex, entityIndex);
+}
+
+// the field argument of et.gentity_get/set is either a name or a handle from et.gentity_field()
+static gentity_field_t *_et_gentity_checkfield(lua_State *L, gentity_t *ent, int arg, const char **fieldname)
+{
+	gentity_field_t *field;
+
+	if (lua_type(L, arg) == LUA_TNUMBER)
+	{
+		int handle = (int)lua_tointeger(L, arg);
+
+		field      = _et_gentity_fieldbyindex(ent, FIELD_HANDLE_GCLIENT(handle), FIELD_HANDLE_GENTITY(handle));
+		*fieldname = field ? field->name : va("handle %d", handle);
+		return field;
+	}
+
+	*fieldname = luaL_checkstring(L, arg);
+
+	return _et_gentity_getfield(ent, (char *)*fieldname);
+}
+
 static void _et_gentity_getvec3(lua_State *L, vec3_t vec3)
 {
 	lua_newtable(L);
@@ -1639,12 +1763,30 @@ static int _et_G_SetSpawnVar(lua_State *L)
 	return 0;
 }
 
-// variable = et.gentity_get( entnum, fieldname, arrayindex )
+// handle = et.gentity_field( fieldname )
+static int _et_gentity_field(lua_State *L)
+{
+	const char *fieldname = luaL_checkstring(L, 1);
+	int        clientIndex, entityIndex;
+
+	_et_gentity_findfield(fieldname, &clientIndex, &entityIndex);
+
+	if (clientIndex < 0 && entityIndex < 0)
+	{
+		luaL_error(L, "tried to get invalid gentity field \"%s\"", fieldname);
+		return 0;
+	}
+
+	lua_pushinteger(L, FIELD_HANDLE(clientIndex, entityIndex));
+	return 1;
+}
+
+// variable = et.gentity_get( entnum, fieldname or fieldhandle, arrayindex )
 static int _et_gentity_get(lua_State *L)
 {
-	gentity_t       *ent       = g_entities + (int)luaL_checkinteger(L, 1);
-	const char      *fieldname = luaL_checkstring(L, 2);
-	gentity_field_t *field     = _et_gentity_getfield(ent, (char *)fieldname);
+	gentity_t       *ent = g_entities + (int)luaL_checkinteger(L, 1);
+	const char      *fieldname;
+	gentity_field_t *field = _et_gentity_checkfield(L, ent, 2, &fieldname);
 	unsigned long   addr;
 
 	// break on invalid gentity field
@@ -1725,12 +1867,12 @@ static int _et_gentity_get(lua_State *L)
 	return 0;
 }
 
-// et.gentity_set( entnum, fieldname, arrayindex, value )
+// et.gentity_set( entnum, fieldname or fieldhandle, arrayindex, value )
 static int _et_gentity_set(lua_State *L)
 {
-	gentity_t       *ent       = g_entities + (int)luaL_checkinteger(L, 1);
-	const char      *fieldname = luaL_checkstring(L, 2);
-	gentity_field_t *field     = _et_gentity_getfield(ent, (char *)fieldname);
+	gentity_t       *ent = g_entities + (int)luaL_checkinteger(L, 1);
+	const char      *fieldname;
+	gentity_field_t *field = _et_gentity_checkfield(L, ent, 2, &fieldname);
 	unsigned long   addr;
 	const char      *buffer;
 
@@ -2082,6 +2224,7 @@ static const luaL_Reg etlib[] =
 	{ "trap_UnlinkEntity",       _et_trap_UnlinkEntity       },
 	{ "G_GetSpawnVar",           _et_G_GetSpawnVar           },
 	{ "G_SetSpawnVar",           _et_G_SetSpawnVar           },
+	{ "gentity_field",           _et_gentity_field           },
 	{ "gentity_get",             _et_gentity_get             },
 	{ "gentity_set",             _et_gentity_set             },
 	{ "G_AddEvent",              _et_G_AddEvent              },
@@ -2105,7 +2248,7 @@ static const luaL_Reg etlib[] =
  */
 qboolean G_LuaRunIsolated(const char *modName)
 {
-	int          freeVM, flen = 0;
+	int          freeVM, flen = 0, i;
 	static char  allowedModules[MAX_CVAR_VALUE_STRING];
 	char         *code, *signature;
 	fileHandle_t f;
@@ -2170,6 +2313,7 @@ qboolean G_LuaRunIsolated(const char *modName)
 				G_Error("%s API: %svm memory allocation error for %s data\n", LUA_VERSION, S_COLOR_BLUE, modName);
 			}
 
+			Com_Memset(vm, 0, sizeof(*vm));
 			vm->id = -1;
 			Q_strncpyz(vm->file_name, modName, sizeof(vm->file_name));
 			Q_strncpyz(vm->mod_name, "", sizeof(vm->mod_name));
@@ -2177,12 +2321,17 @@ qboolean G_LuaRunIsolated(const char *modName)
 			vm->code      = code;
 			vm->code_size = flen;
 			vm->err       = 0;
+			for (i = 0; i < LUA_NUM_HOOKS; i++)
+			{
+				vm->hookRefs[i] = LUA_NOREF;
+			}
 
 			// Start lua virtual machine
 			if (G_LuaStartVM(vm))
 			{
 				vm->id      = freeVM;
 				lVM[freeVM] = vm;
+				G_LuaResolveHooks(vm);
 				return qtrue;
 			}
 			else
@@ -2252,13 +2401,131 @@ qboolean G_LuaInit(void)
 	return qtrue;
 }
 
+/*
+ * G_LuaAlloc( ud, ptr, osize, nsize )
+ * lua_Alloc keeping track of the memory used by a VM, forwards to the default allocator.
+ */
+static void *G_LuaAlloc(void *ud, void *ptr, size_t osize, size_t nsize)
+{
+	lua_vm_t *vm = (lua_vm_t *)ud;
+	void     *res;
+
+	// osize is the type of the object when ptr is NULL
+	if (!ptr)
+	{
+		osize = 0;
+	}
+
+	res = vm->allocf(vm->allocud, ptr, osize, nsize);
+
+	if (nsize == 0 || res)
+	{
+		vm->memUsed -= osize;
+		vm->memUsed += nsize;
+		if (vm->memUsed > vm->memPeak)
+		{
+			vm->memPeak = vm->memUsed;
+		}
+		if (nsize > osize)
+		{
+			vm->memAllocs++;
+		}
+	}
+
+	return res;
+}
+
+/*
+ * G_LuaBudgetHook( L, ar )
+ * Count hook aborting a call which runs more than lua_maxInstructions instructions.
+ * Once exceeded it keeps raising the error until the call returns, so a script
+ * catching it with its own pcall can't keep running.
+ */
+static void G_LuaBudgetHook(lua_State *L, lua_Debug *ar)
+{
+	lua_vm_t *vm = *(lua_vm_t **)lua_getextraspace(L);
+
+	if (!vm || lua_maxInstructions.integer <= 0)
+	{
+		return;
+	}
+
+	vm->budgetUsed += vm->budgetStep;
+
+	if (vm->suspended || vm->budgetUsed > lua_maxInstructions.integer)
+	{
+		vm->suspended = qtrue;
+		luaL_error(L, "instruction budget of %d exceeded", lua_maxInstructions.integer);
+	}
+}
+
+/*
+ * G_LuaBudgetStart( vm )
+ * Starts the instruction budget of an outermost call, (un)installs the count hook when lua_maxInstructions changed.
+ */
+static void G_LuaBudgetStart(lua_vm_t *vm)
+{
+	// a budget below LUA_BUDGET_STEP is checked at every instruction it allows
+	int step = MIN(LUA_BUDGET_STEP, lua_maxInstructions.integer);
+
+	vm->budgetUsed = 0;
+
+	if (step > 0)
+	{
+		if (vm->budgetStep != step)
+		{
+			lua_sethook(vm->L, G_LuaBudgetHook, LUA_MASKCOUNT, step);
+			vm->budgetStep = step;
+		}
+	}
+	else if (vm->budgetStep)
+	{
+		lua_sethook(vm->L, NULL, 0, 0);
+		vm->budgetStep = 0;
+	}
+}
+
+/*
+ * G_LuaSuspend( vm )
+ * Stops sending callbacks to a VM which exceeded its instruction budget, until lua_restart.
+ */
+static void G_LuaSuspend(lua_vm_t *vm)
+{
+	int i;
+
+	if (vm->id >= 0)
+	{
+		for (i = 0; i < LUA_NUM_HOOKS; i++)
+		{
+			luaHookVMs[i] &= ~(1 << vm->id);
+		}
+	}
+
+	G_Printf("%s API: %sLua module [%s] [%s] suspended, it exceeded lua_maxInstructions (%d)\n", LUA_VERSION, S_COLOR_BLUE, vm->file_name, vm->mod_signature, lua_maxInstructions.integer);
+}
+
 /*
  * G_LuaCall( func, vm, nargs, nresults )
  * Calls a function already on the stack.
  */
 qboolean G_LuaCall(lua_vm_t *vm, const char *func, int nargs, int nresults)
 {
-	switch (lua_pcall(vm->L, nargs, nresults, 0))
+	int      res;
+	qboolean suspended = vm->suspended;
+
+	if (vm->callDepth++ == 0)
+	{
+		G_LuaBudgetStart(vm);
+	}
+
+	res = lua_pcall(vm->L, nargs, nresults, 0);
+
+	if (--vm->callDepth == 0 && vm->suspended && !suspended)
+	{
+		G_LuaSuspend(vm);
+	}
+
+	switch (res)
 	{
 	case LUA_ERRRUN:
 		// made output more ETPro compatible
@@ -2280,6 +2547,46 @@ qboolean G_LuaCall(lua_vm_t *vm, const char *func, int nargs, int nresults)
 	return qtrue;
 }
 
+/*
+ * G_LuaCallHook( vm, hook, nargs, nresults )
+ * Calls a callback already on the stack and accounts the wall time spent in it.
+ * trap_Milliseconds only has whole milliseconds: a short call counts as 0 or 1ms
+ * depending on whether a tick passes during it, which averages out in the totals.
+ */
+static qboolean G_LuaCallHook(lua_vm_t *vm, luaHook_t hook, int nargs, int nresults)
+{
+	luaCallStats_t *stats = &vm->stats[hook];
+	int            start  = trap_Milliseconds();
+	qboolean       res    = G_LuaCall(vm, luaHookNames[hook], nargs, nresults);
+	int            time   = trap_Milliseconds() - start;
+
+	stats->calls++;
+	stats->totalTime += time;
+	if (time > stats->maxTime)
+	{
+		stats->maxTime = time;
+	}
+
+	if (time < 1)
+	{
+		stats->buckets[0]++;
+	}
+	else if (time < 5)
+	{
+		stats->buckets[1]++;
+	}
+	else if (time < 20)
+	{
+		stats->buckets[2]++;
+	}
+	else
+	{
+		stats->buckets[3]++;
+	}
+
+	return res;
+}
+
 /*
  * G_LuaGetNamedFunction( vm, name )
  * Finds a function by name and puts it onto the stack.
@@ -2303,6 +2610,55 @@ qboolean G_LuaGetNamedFunction(lua_vm_t *vm, const char *name)
 	return qfalse;
 }
 
+/*
+ * G_LuaGetHookFunction( vm, hook )
+ * Puts the callback resolved by G_LuaResolveHooks() onto the stack.
+ * If the VM does not implement it, returns qfalse.
+ */
+qboolean G_LuaGetHookFunction(lua_vm_t *vm, luaHook_t hook)
+{
+	if (vm->L && vm->id >= 0 && (luaHookVMs[hook] & (1 << vm->id)))
+	{
+		lua_rawgeti(vm->L, LUA_REGISTRYINDEX, vm->hookRefs[hook]);
+		return qtrue;
+	}
+	return qfalse;
+}
+
+/*
+ * G_LuaResolveHooks( vm )
+ * Looks up all callbacks of a registered VM once and keeps them as registry references.
+ * Called after the script is loaded and after et_InitGame, callbacks defined
+ * or replaced at any other time are not seen.
+ */
+void G_LuaResolveHooks(lua_vm_t *vm)
+{
+	int i;
+
+	if (!vm->L || vm->id < 0 || vm->suspended)
+	{
+		return;
+	}
+
+	for (i = 0; i < LUA_NUM_HOOKS; i++)
+	{
+		luaL_unref(vm->L, LUA_REGISTRYINDEX, vm->hookRefs[i]);
+		vm->hookRefs[i] = LUA_NOREF;
+		luaHookVMs[i]  &= ~(1 << vm->id);
+
+		lua_getglobal(vm->L, luaHookNames[i]);
+		if (lua_isfunction(vm->L, -1))
+		{
+			vm->hookRefs[i] = luaL_ref(vm->L, LUA_REGISTRYINDEX);
+			luaHookVMs[i]  |= (1 << vm->id);
+		}
+		else
+		{
+			lua_pop(vm->L, 1);
+		}
+	}
+}
+
 /**
  * @brief Dump the lua stack to console
  *        Executed by the ingame "lua_api" command
@@ -2816,6 +3172,13 @@ qboolean G_LuaStartVM(lua_vm_t *vm)
 		return qfalse;
 	}
 
+	// account the memory of the VM, see lua_status
+	vm->allocf  = lua_getallocf(vm->L, &vm->allocud);
+	vm->memUsed = (size_t)lua_gc(vm->L, LUA_GCCOUNT, 0) * 1024 + (size_t)lua_gc(vm->L, LUA_GCCOUNTB, 0);
+	vm->memPeak = vm->memUsed;
+	lua_setallocf(vm->L, G_LuaAlloc, vm);
+	*(lua_vm_t **)lua_getextraspace(vm->L) = vm;
+
 	// Initialise the lua state
 	luaL_openlibs(vm->L);
 
@@ -2936,6 +3299,13 @@ void G_LuaStopVM(lua_vm_t *vm)
 	}
 	if (vm->id >= 0)
 	{
+		int i;
+
+		for (i = 0; i < LUA_NUM_HOOKS; i++)
+		{
+			luaHookVMs[i] &= ~(1 << vm->id);
+		}
+
 		if (lVM[vm->id] == vm)
 		{
 			lVM[vm->id] = NULL;
@@ -3016,6 +3386,35 @@ void G_LuaStatus(gentity_t *ent)
 		}
 	}
 	G_refPrintf(ent, "-- ------------------------ ---------------------------------------- ------------------------");
+
+	// wall time and memory accounting
+	G_refPrintf(ent, "%-2s %-26s %8s %10s %8s %7s %7s %7s %7s", "VM", "Callback", "Calls", "Total ms", "Max ms", "<1ms", "<5ms", "<20ms", ">=20ms");
+	G_refPrintf(ent, "-- -------------------------- -------- ---------- -------- ------- ------- ------- -------");
+	for (i = 0; i < LUA_NUM_VM; i++)
+	{
+		int            j;
+		luaCallStats_t *stats;
+
+		if (!lVM[i])
+		{
+			continue;
+		}
+
+		G_refPrintf(ent, "%2d memory %uKB, peak %uKB, %d allocations%s", lVM[i]->id, (unsigned int)(lVM[i]->memUsed / 1024), (unsigned int)(lVM[i]->memPeak / 1024), lVM[i]->memAllocs,
+		            lVM[i]->suspended ? ", ^1suspended^7 (exceeded lua_maxInstructions)" : "");
+
+		for (j = 0; j < LUA_NUM_HOOKS; j++)
+		{
+			stats = &lVM[i]->stats[j];
+			if (!stats->calls)
+			{
+				continue;
+			}
+			G_refPrintf(ent, "%2d %-26s %8d %10d %8d %7d %7d %7d %7d", lVM[i]->id, luaHookNames[j], stats->calls, stats->totalTime, stats->maxTime,
+			            stats->buckets[0], stats->buckets[1], stats->buckets[2], stats->buckets[3]);
+		}
+	}
+	G_refPrintf(ent, "-- -------------------------- -------- ---------- -------- ------- ------- ------- -------");
 }
 
 /*
@@ -3052,6 +3451,12 @@ void G_LuaHook_InitGame(int levelTime, int randomSeed, int restart)
 	int      i;
 	lua_vm_t *vm;
 
+	// nothing to do if no VM implements the callback
+	if (!luaHookVMs[LUA_HOOK_INITGAME])
+	{
+		return;
+	}
+
 	for (i = 0; i < LUA_NUM_VM; i++)
 	{
 		vm = lVM[i];
@@ -3061,7 +3466,7 @@ void G_LuaHook_InitGame(int levelTime, int randomSeed, int restart)
 			{
 				continue;
 			}
-			if (!G_LuaGetNamedFunction(vm, "et_InitGame"))
+			if (!G_LuaGetHookFunction(vm, LUA_HOOK_INITGAME))
 			{
 				continue;
 			}
@@ -3070,11 +3475,13 @@ void G_LuaHook_InitGame(int levelTime, int randomSeed, int restart)
 			lua_pushinteger(vm->L, randomSeed);
 			lua_pushinteger(vm->L, restart);
 			// Call
-			if (!G_LuaCall(vm, "et_InitGame", 3, 0))
+			if (!G_LuaCallHook(vm, LUA_HOOK_INITGAME, 3, 0))
 			{
 				//G_LuaStopVM(vm);
 				continue;
 			}
+			// pick up callbacks the script defined while initialising
+			G_LuaResolveHooks(vm);
 		}
 	}
 }
@@ -3088,6 +3495,12 @@ void G_LuaHook_ShutdownGame(int restart)
 	int      i;
 	lua_vm_t *vm;
 
+	// nothing to do if no VM implements the callback
+	if (!luaHookVMs[LUA_HOOK_SHUTDOWNGAME])
+	{
+		return;
+	}
+
 	for (i = 0; i < LUA_NUM_VM; i++)
 	{
 		vm = lVM[i];
@@ -3097,14 +3510,14 @@ void G_LuaHook_ShutdownGame(int restart)
 			{
 				continue;
 			}
-			if (!G_LuaGetNamedFunction(vm, "et_ShutdownGame"))
+			if (!G_LuaGetHookFunction(vm, LUA_HOOK_SHUTDOWNGAME))
 			{
 				continue;
 			}
 			// Arguments
 			lua_pushinteger(vm->L, restart);
 			// Call
-			if (!G_LuaCall(vm, "et_ShutdownGame", 1, 0))
+			if (!G_LuaCallHook(vm, LUA_HOOK_SHUTDOWNGAME, 1, 0))
 			{
 				//G_LuaStopVM(vm);
 				continue;
@@ -3122,6 +3535,12 @@ void G_LuaHook_RunFrame(int levelTime)
 	int      i;
 	lua_vm_t *vm;
 
+	// nothing to do if no VM implements the callback
+	if (!luaHookVMs[LUA_HOOK_RUNFRAME])
+	{
+		return;
+	}
+
 	for (i = 0; i < LUA_NUM_VM; i++)
 	{
 		vm = lVM[i];
@@ -3131,14 +3550,14 @@ void G_LuaHook_RunFrame(int levelTime)
 			{
 				continue;
 			}
-			if (!G_LuaGetNamedFunction(vm, "et_RunFrame"))
+			if (!G_LuaGetHookFunction(vm, LUA_HOOK_RUNFRAME))
 			{
 				continue;
 			}
 			// Arguments
 			lua_pushinteger(vm->L, levelTime);
 			// Call
-			if (!G_LuaCall(vm, "et_RunFrame", 1, 0))
+			if (!G_LuaCallHook(vm, LUA_HOOK_RUNFRAME, 1, 0))
 			{
 				//G_LuaStopVM(vm);
 				continue;
@@ -3156,6 +3575,12 @@ qboolean G_LuaHook_ClientConnect(int clientNum, qboolean firstTime, qboolean isB
 	int      i;
 	lua_vm_t *vm;
 
+	// nothing to do if no VM implements the callback
+	if (!luaHookVMs[LUA_HOOK_CLIENTCONNECT])
+	{
+		return qfalse;
+	}
+
 	for (i = 0; i < LUA_NUM_VM; i++)
 	{
 		vm = lVM[i];
@@ -3165,7 +3590,7 @@ qboolean G_LuaHook_ClientConnect(int clientNum, qboolean firstTime, qboolean isB
 			{
 				continue;
 			}
-			if (!G_LuaGetNamedFunction(vm, "et_ClientConnect"))
+			if (!G_LuaGetHookFunction(vm, LUA_HOOK_CLIENTCONNECT))
 			{
 				continue;
 			}
@@ -3174,7 +3599,7 @@ qboolean G_LuaHook_ClientConnect(int clientNum, qboolean firstTime, qboolean isB
 			lua_pushinteger(vm->L, (int)firstTime);
 			lua_pushinteger(vm->L, (int)isBot);
 			// Call
-			if (!G_LuaCall(vm, "et_ClientConnect", 3, 1))
+			if (!G_LuaCallHook(vm, LUA_HOOK_CLIENTCONNECT, 3, 1))
 			{
 				//G_LuaStopVM(vm);
 				continue;
@@ -3201,6 +3626,12 @@ void G_LuaHook_ClientDisconnect(int clientNum)
 	int      i;
 	lua_vm_t *vm;
 
+	// nothing to do if no VM implements the callback
+	if (!luaHookVMs[LUA_HOOK_CLIENTDISCONNECT])
+	{
+		return;
+	}
+
 	for (i = 0; i < LUA_NUM_VM; i++)
 	{
 		vm = lVM[i];
@@ -3210,14 +3641,14 @@ void G_LuaHook_ClientDisconnect(int clientNum)
 			{
 				continue;
 			}
-			if (!G_LuaGetNamedFunction(vm, "et_ClientDisconnect"))
+			if (!G_LuaGetHookFunction(vm, LUA_HOOK_CLIENTDISCONNECT))
 			{
 				continue;
 			}
 			// Arguments
 			lua_pushinteger(vm->L, clientNum);
 			// Call
-			if (!G_LuaCall(vm, "et_ClientDisconnect", 1, 0))
+			if (!G_LuaCallHook(vm, LUA_HOOK_CLIENTDISCONNECT, 1, 0))
 			{
 				//G_LuaStopVM(vm);
 				continue;
@@ -3235,6 +3666,12 @@ void G_LuaHook_ClientBegin(int clientNum)
 	int      i;
 	lua_vm_t *vm;
 
+	// nothing to do if no VM implements the callback
+	if (!luaHookVMs[LUA_HOOK_CLIENTBEGIN])
+	{
+		return;
+	}
+
 	for (i = 0; i < LUA_NUM_VM; i++)
 	{
 		vm = lVM[i];
@@ -3244,14 +3681,14 @@ void G_LuaHook_ClientBegin(int clientNum)
 			{
 				continue;
 			}
-			if (!G_LuaGetNamedFunction(vm, "et_ClientBegin"))
+			if (!G_LuaGetHookFunction(vm, LUA_HOOK_CLIENTBEGIN))
 			{
 				continue;
 			}
 			// Arguments
 			lua_pushinteger(vm->L, clientNum);
 			// Call
-			if (!G_LuaCall(vm, "et_ClientBegin", 1, 0))
+			if (!G_LuaCallHook(vm, LUA_HOOK_CLIENTBEGIN, 1, 0))
 			{
 				//G_LuaStopVM(vm);
 				continue;
@@ -3269,6 +3706,12 @@ void G_LuaHook_ClientUserinfoChanged(int clientNum)
 	int      i;
 	lua_vm_t *vm;
 
+	// nothing to do if no VM implements the callback
+	if (!luaHookVMs[LUA_HOOK_CLIENTUSERINFOCHANGED])
+	{
+		return;
+	}
+
 	for (i = 0; i < LUA_NUM_VM; i++)
 	{
 		vm = lVM[i];
@@ -3278,14 +3721,14 @@ void G_LuaHook_ClientUserinfoChanged(int clientNum)
 			{
 				continue;
 			}
-			if (!G_LuaGetNamedFunction(vm, "et_ClientUserinfoChanged"))
+			if (!G_LuaGetHookFunction(vm, LUA_HOOK_CLIENTUSERINFOCHANGED))
 			{
 				continue;
 			}
 			// Arguments
 			lua_pushinteger(vm->L, clientNum);
 			// Call
-			if (!G_LuaCall(vm, "et_ClientUserinfoChanged", 1, 0))
+			if (!G_LuaCallHook(vm, LUA_HOOK_CLIENTUSERINFOCHANGED, 1, 0))
 			{
 				//G_LuaStopVM(vm);
 				continue;
@@ -3303,6 +3746,12 @@ void G_LuaHook_ClientSpawn(int clientNum, qboolean revived, qboolean teamChange,
 	int      i;
 	lua_vm_t *vm;
 
+	// nothing to do if no VM implements the callback
+	if (!luaHookVMs[LUA_HOOK_CLIENTSPAWN])
+	{
+		return;
+	}
+
 	for (i = 0; i < LUA_NUM_VM; i++)
 	{
 		vm = lVM[i];
@@ -3312,7 +3761,7 @@ void G_LuaHook_ClientSpawn(int clientNum, qboolean revived, qboolean teamChange,
 			{
 				continue;
 			}
-			if (!G_LuaGetNamedFunction(vm, "et_ClientSpawn"))
+			if (!G_LuaGetHookFunction(vm, LUA_HOOK_CLIENTSPAWN))
 			{
 				continue;
 			}
@@ -3322,7 +3771,7 @@ void G_LuaHook_ClientSpawn(int clientNum, qboolean revived, qboolean teamChange,
 			lua_pushinteger(vm->L, (int)teamChange);
 			lua_pushinteger(vm->L, (int)restoreHealth);
 			// Call
-			if (!G_LuaCall(vm, "et_ClientSpawn", 4, 0))
+			if (!G_LuaCallHook(vm, LUA_HOOK_CLIENTSPAWN, 4, 0))
 			{
 				//G_LuaStopVM(vm);
 				continue;
@@ -3340,6 +3789,12 @@ qboolean G_LuaHook_ClientCommand(int clientNum, char *command)
 	int      i;
 	lua_vm_t *vm;
 
+	// nothing to do if no VM implements the callback
+	if (!luaHookVMs[LUA_HOOK_CLIENTCOMMAND])
+	{
+		return qfalse;
+	}
+
 	for (i = 0; i < LUA_NUM_VM; i++)
 	{
 		vm = lVM[i];
@@ -3349,7 +3804,7 @@ qboolean G_LuaHook_ClientCommand(int clientNum, char *command)
 			{
 				continue;
 			}
-			if (!G_LuaGetNamedFunction(vm, "et_ClientCommand"))
+			if (!G_LuaGetHookFunction(vm, LUA_HOOK_CLIENTCOMMAND))
 			{
 				continue;
 			}
@@ -3357,7 +3812,7 @@ qboolean G_LuaHook_ClientCommand(int clientNum, char *command)
 			lua_pushinteger(vm->L, clientNum);
 			lua_pushstring(vm->L, command);
 			// Call
-			if (!G_LuaCall(vm, "et_ClientCommand", 2, 1))
+			if (!G_LuaCallHook(vm, LUA_HOOK_CLIENTCOMMAND, 2, 1))
 			{
 				//G_LuaStopVM(vm);
 				continue;
@@ -3386,6 +3841,12 @@ qboolean G_LuaHook_ConsoleCommand(char *command)
 	int      i;
 	lua_vm_t *vm;
 
+	// nothing to do if no VM implements the callback
+	if (!luaHookVMs[LUA_HOOK_CONSOLECOMMAND])
+	{
+		return qfalse;
+	}
+
 	for (i = 0; i < LUA_NUM_VM; i++)
 	{
 		vm = lVM[i];
@@ -3395,14 +3856,14 @@ qboolean G_LuaHook_ConsoleCommand(char *command)
 			{
 				continue;
 			}
-			if (!G_LuaGetNamedFunction(vm, "et_ConsoleCommand"))
+			if (!G_LuaGetHookFunction(vm, LUA_HOOK_CONSOLECOMMAND))
 			{
 				continue;
 			}
 			// Arguments
 			lua_pushstring(vm->L, command);
 			// Call
-			if (!G_LuaCall(vm, "et_ConsoleCommand", 1, 1))
+			if (!G_LuaCallHook(vm, LUA_HOOK_CONSOLECOMMAND, 1, 1))
 			{
 				//G_LuaStopVM(vm);
 				continue;
@@ -3431,6 +3892,12 @@ qboolean G_LuaHook_UpgradeSkill(int cno, skillType_t skill)
 	int      i;
 	lua_vm_t *vm;
 
+	// nothing to do if no VM implements the callback
+	if (!luaHookVMs[LUA_HOOK_UPGRADESKILL])
+	{
+		return qfalse;
+	}
+
 	for (i = 0; i < LUA_NUM_VM; i++)
 	{
 		vm = lVM[i];
@@ -3440,7 +3907,7 @@ qboolean G_LuaHook_UpgradeSkill(int cno, skillType_t skill)
 			{
 				continue;
 			}
-			if (!G_LuaGetNamedFunction(vm, "et_UpgradeSkill"))
+			if (!G_LuaGetHookFunction(vm, LUA_HOOK_UPGRADESKILL))
 			{
 				continue;
 			}
@@ -3448,7 +3915,7 @@ qboolean G_LuaHook_UpgradeSkill(int cno, skillType_t skill)
 			lua_pushinteger(vm->L, cno);
 			lua_pushinteger(vm->L, (int)skill);
 			// Call
-			if (!G_LuaCall(vm, "et_UpgradeSkill", 2, 1))
+			if (!G_LuaCallHook(vm, LUA_HOOK_UPGRADESKILL, 2, 1))
 			{
 				//G_LuaStopVM(vm);
 				continue;
@@ -3477,6 +3944,12 @@ qboolean G_LuaHook_SetPlayerSkill(int cno, skillType_t skill)
 	int      i;
 	lua_vm_t *vm;
 
+	// nothing to do if no VM implements the callback
+	if (!luaHookVMs[LUA_HOOK_SETPLAYERSKILL])
+	{
+		return qfalse;
+	}
+
 	for (i = 0; i < LUA_NUM_VM; i++)
 	{
 		vm = lVM[i];
@@ -3486,7 +3959,7 @@ qboolean G_LuaHook_SetPlayerSkill(int cno, skillType_t skill)
 			{
 				continue;
 			}
-			if (!G_LuaGetNamedFunction(vm, "et_SetPlayerSkill"))
+			if (!G_LuaGetHookFunction(vm, LUA_HOOK_SETPLAYERSKILL))
 			{
 				continue;
 			}
@@ -3494,7 +3967,7 @@ qboolean G_LuaHook_SetPlayerSkill(int cno, skillType_t skill)
 			lua_pushinteger(vm->L, cno);
 			lua_pushinteger(vm->L, (int)skill);
 			// Call
-			if (!G_LuaCall(vm, "et_SetPlayerSkill", 2, 1))
+			if (!G_LuaCallHook(vm, LUA_HOOK_SETPLAYERSKILL, 2, 1))
 			{
 				//G_LuaStopVM(vm);
 				continue;
@@ -3516,9 +3989,9 @@ qboolean G_LuaHook_SetPlayerSkill(int cno, skillType_t skill)
 
 static luaPrintFunctions_t g_luaPrintFunctions[] =
 {
-	{ GPRINT_TEXT,      "et_Print"  },
-	{ GPRINT_DEVELOPER, "et_DPrint" },
-	{ GPRINT_ERROR,     "et_Error"  }
+	{ GPRINT_TEXT,      "et_Print",  LUA_HOOK_PRINT  },
+	{ GPRINT_DEVELOPER, "et_DPrint", LUA_HOOK_DPRINT },
+	{ GPRINT_ERROR,     "et_Error",  LUA_HOOK_ERROR  }
 };
 
 /*
@@ -3530,6 +4003,12 @@ void G_LuaHook_Print(printMessageType_t category, char *text)
 	int      i;
 	lua_vm_t *vm;
 
+	// nothing to do if no VM implements the callback
+	if (!luaHookVMs[g_luaPrintFunctions[category].hook])
+	{
+		return;
+	}
+
 	for (i = 0; i < LUA_NUM_VM; i++)
 	{
 		vm = lVM[i];
@@ -3539,14 +4018,14 @@ void G_LuaHook_Print(printMessageType_t category, char *text)
 			{
 				continue;
 			}
-			if (!G_LuaGetNamedFunction(vm, g_luaPrintFunctions[category].function))
+			if (!G_LuaGetHookFunction(vm, g_luaPrintFunctions[category].hook))
 			{
 				continue;
 			}
 			// Arguments
 			lua_pushstring(vm->L, text);
 			// Call
-			if (!G_LuaCall(vm, g_luaPrintFunctions[category].function, 1, 0))
+			if (!G_LuaCallHook(vm, g_luaPrintFunctions[category].hook, 1, 0))
 			{
 				//G_LuaStopVM(vm);
 				continue;
@@ -3569,6 +4048,12 @@ qboolean G_LuaHook_Obituary(int victim, int killer, int meansOfDeath)
 	int      i;
 	lua_vm_t *vm;
 
+	// nothing to do if no VM implements the callback
+	if (!luaHookVMs[LUA_HOOK_OBITUARY])
+	{
+		return qfalse;
+	}
+
 	for (i = 0; i < LUA_NUM_VM; i++)
 	{
 		vm = lVM[i];
@@ -3578,7 +4063,7 @@ qboolean G_LuaHook_Obituary(int victim, int killer, int meansOfDeath)
 			{
 				continue;
 			}
-			if (!G_LuaGetNamedFunction(vm, "et_Obituary"))
+			if (!G_LuaGetHookFunction(vm, LUA_HOOK_OBITUARY))
 			{
 				continue;
 			}
@@ -3588,7 +4073,7 @@ qboolean G_LuaHook_Obituary(int victim, int killer, int meansOfDeath)
 			lua_pushinteger(vm->L, meansOfDeath);
 
 			// Call
-			if (!G_LuaCall(vm, "et_Obituary", 3, 1))
+			if (!G_LuaCallHook(vm, LUA_HOOK_OBITUARY, 3, 1))
 			{
 				//G_LuaStopVM(vm);
 				continue;
@@ -3612,6 +4097,12 @@ qboolean G_LuaHook_Damage(int target, int attacker, int damage, int dflags, mean
 	int      i;
 	lua_vm_t *vm;
 
+	// nothing to do if no VM implements the callback
+	if (!luaHookVMs[LUA_HOOK_DAMAGE])
+	{
+		return qfalse;
+	}
+
 	for (i = 0; i < LUA_NUM_VM; i++)
 	{
 		vm = lVM[i];
@@ -3621,7 +4112,7 @@ qboolean G_LuaHook_Damage(int target, int attacker, int damage, int dflags, mean
 			{
 				continue;
 			}
-			if (!G_LuaGetNamedFunction(vm, "et_Damage"))
+			if (!G_LuaGetHookFunction(vm, LUA_HOOK_DAMAGE))
 			{
 				continue;
 			}
@@ -3632,7 +4123,7 @@ qboolean G_LuaHook_Damage(int target, int attacker, int damage, int dflags, mean
 			lua_pushinteger(vm->L, dflags);
 			lua_pushinteger(vm->L, mod);
 			// Call
-			if (!G_LuaCall(vm, "et_Damage", 5, 1))
+			if (!G_LuaCallHook(vm, LUA_HOOK_DAMAGE, 5, 1))
 			{
 				//G_LuaStopVM(vm);
 				continue;
@@ -3656,6 +4147,12 @@ qboolean G_LuaHook_WeaponFire(int clientNum, weapon_t weapon, gentity_t **pFired
 	int      i;
 	lua_vm_t *vm;
 
+	// nothing to do if no VM implements the callback
+	if (!luaHookVMs[LUA_HOOK_WEAPONFIRE])
+	{
+		return qfalse;
+	}
+
 	for (i = 0; i < LUA_NUM_VM; i++)
 	{
 		vm = lVM[i];
@@ -3665,7 +4162,7 @@ qboolean G_LuaHook_WeaponFire(int clientNum, weapon_t weapon, gentity_t **pFired
 			{
 				continue;
 			}
-			if (!G_LuaGetNamedFunction(vm, "et_WeaponFire"))
+			if (!G_LuaGetHookFunction(vm, LUA_HOOK_WEAPONFIRE))
 			{
 				continue;
 			}
@@ -3673,7 +4170,7 @@ qboolean G_LuaHook_WeaponFire(int clientNum, weapon_t weapon, gentity_t **pFired
 			lua_pushinteger(vm->L, clientNum);
 			lua_pushinteger(vm->L, weapon);
 			// Call
-			if (!G_LuaCall(vm, "et_WeaponFire", 2, 2))
+			if (!G_LuaCallHook(vm, LUA_HOOK_WEAPONFIRE, 2, 2))
 			{
 				continue;
 			}
@@ -3704,6 +4201,12 @@ qboolean G_LuaHook_FixedMGFire(int clientNum)
 	int      i;
 	lua_vm_t *vm;
 
+	// nothing to do if no VM implements the callback
+	if (!luaHookVMs[LUA_HOOK_FIXEDMGFIRE])
+	{
+		return qfalse;
+	}
+
 	for (i = 0; i < LUA_NUM_VM; i++)
 	{
 		vm = lVM[i];
@@ -3713,14 +4216,14 @@ qboolean G_LuaHook_FixedMGFire(int clientNum)
 			{
 				continue;
 			}
-			if (!G_LuaGetNamedFunction(vm, "et_FixedMGFire"))
+			if (!G_LuaGetHookFunction(vm, LUA_HOOK_FIXEDMGFIRE))
 			{
 				continue;
 			}
 			// Arguments
 			lua_pushinteger(vm->L, clientNum);
 			// Call
-			if (!G_LuaCall(vm, "et_FixedMGFire", 1, 1))
+			if (!G_LuaCallHook(vm, LUA_HOOK_FIXEDMGFIRE, 1, 1))
 			{
 				continue;
 			}
@@ -3743,6 +4246,12 @@ qboolean G_LuaHook_MountedMGFire(int clientNum)
 	int      i;
 	lua_vm_t *vm;
 
+	// nothing to do if no VM implements the callback
+	if (!luaHookVMs[LUA_HOOK_MOUNTEDMGFIRE])
+	{
+		return qfalse;
+	}
+
 	for (i = 0; i < LUA_NUM_VM; i++)
 	{
 		vm = lVM[i];
@@ -3752,14 +4261,14 @@ qboolean G_LuaHook_MountedMGFire(int clientNum)
 			{
 				continue;
 			}
-			if (!G_LuaGetNamedFunction(vm, "et_MountedMGFire"))
+			if (!G_LuaGetHookFunction(vm, LUA_HOOK_MOUNTEDMGFIRE))
 			{
 				continue;
 			}
 			// Arguments
 			lua_pushinteger(vm->L, clientNum);
 			// Call
-			if (!G_LuaCall(vm, "et_MountedMGFire", 1, 1))
+			if (!G_LuaCallHook(vm, LUA_HOOK_MOUNTEDMGFIRE, 1, 1))
 			{
 				continue;
 			}
@@ -3782,6 +4291,12 @@ qboolean G_LuaHook_AAGunFire(int clientNum)
 	int      i;
 	lua_vm_t *vm;
 
+	// nothing to do if no VM implements the callback
+	if (!luaHookVMs[LUA_HOOK_AAGUNFIRE])
+	{
+		return qfalse;
+	}
+
 	for (i = 0; i < LUA_NUM_VM; i++)
 	{
 		vm = lVM[i];
@@ -3791,14 +4306,14 @@ qboolean G_LuaHook_AAGunFire(int clientNum)
 			{
 				continue;
 			}
-			if (!G_LuaGetNamedFunction(vm, "et_AAGunFire"))
+			if (!G_LuaGetHookFunction(vm, LUA_HOOK_AAGUNFIRE))
 			{
 				continue;
 			}
 			// Arguments
 			lua_pushinteger(vm->L, clientNum);
 			// Call
-			if (!G_LuaCall(vm, "et_AAGunFire", 1, 1))
+			if (!G_LuaCallHook(vm, LUA_HOOK_AAGUNFIRE, 1, 1))
 			{
 				continue;
 			}
@@ -3823,6 +4338,12 @@ void G_LuaHook_SpawnEntitiesFromString()
 	int      i;
 	lua_vm_t *vm;
 
+	// nothing to do if no VM implements the callback
+	if (!luaHookVMs[LUA_HOOK_SPAWNENTITIESFROMSTRING])
+	{
+		return;
+	}
+
 	for (i = 0; i < LUA_NUM_VM; i++)
 	{
 		vm = lVM[i];
@@ -3832,13 +4353,13 @@ void G_LuaHook_SpawnEntitiesFromString()
 			{
 				continue;
 			}
-			if (!G_LuaGetNamedFunction(vm, "et_SpawnEntitiesFromString"))
+			if (!G_LuaGetHookFunction(vm, LUA_HOOK_SPAWNENTITIESFROMSTRING))
 			{
 				continue;
 			}
 
 			// Call
-			if (!G_LuaCall(vm, "et_SpawnEntitiesFromString", 0, 0))
+			if (!G_LuaCallHook(vm, LUA_HOOK_SPAWNENTITIESFROMSTRING, 0, 0))
 			{
 				//G_LuaStopVM(vm);
 				continue;
@@ -76,6 +76,54 @@
 #define _et_gclient_addfield(n, t, f) { #n, t, offsetof(struct gclient_s, n), FIELD_FLAG_GCLIENT + f }
 #define _et_gclient_addfieldalias(n, a, t, f) { #n, t, offsetof(struct gclient_s, a), FIELD_FLAG_GCLIENT + f }
 
+/**
+ * @enum luaHook_e
+ * @typedef luaHook_t
+ * @brief Callbacks which are resolved once per VM, see G_LuaResolveHooks()
+ */
+typedef enum luaHook_e
+{
+	LUA_HOOK_INITGAME = 0,
+	LUA_HOOK_SHUTDOWNGAME,
+	LUA_HOOK_RUNFRAME,
+	LUA_HOOK_CLIENTCONNECT,
+	LUA_HOOK_CLIENTDISCONNECT,
+	LUA_HOOK_CLIENTBEGIN,
+	LUA_HOOK_CLIENTUSERINFOCHANGED,
+	LUA_HOOK_CLIENTSPAWN,
+	LUA_HOOK_CLIENTCOMMAND,
+	LUA_HOOK_CONSOLECOMMAND,
+	LUA_HOOK_UPGRADESKILL,
+	LUA_HOOK_SETPLAYERSKILL,
+	LUA_HOOK_PRINT,
+	LUA_HOOK_DPRINT,
+	LUA_HOOK_ERROR,
+	LUA_HOOK_OBITUARY,
+	LUA_HOOK_DAMAGE,
+	LUA_HOOK_WEAPONFIRE,
+	LUA_HOOK_FIXEDMGFIRE,
+	LUA_HOOK_MOUNTEDMGFIRE,
+	LUA_HOOK_AAGUNFIRE,
+	LUA_HOOK_SPAWNENTITIESFROMSTRING,
+	LUA_NUM_HOOKS
+} luaHook_t;
+
+#define LUA_TIME_BUCKETS 4          ///< callback time histogram: <1ms, <5ms, <20ms, >=20ms
+#define LUA_BUDGET_STEP  1000       ///< instructions between two lua_maxInstructions checks
+
+/**
+ * @struct luaCallStats_s
+ * @typedef luaCallStats_t
+ * @brief Wall time spent in one callback of a VM
+ */
+typedef struct luaCallStats_s
+{
+	int calls;
+	int totalTime;                  ///< ms
+	int maxTime;                    ///< ms
+	int buckets[LUA_TIME_BUCKETS];
+} luaCallStats_t;
+
 /**
  * @struct lua_vm_s
  * @brief
@@ -90,6 +138,19 @@ typedef struct
 	int code_size;
 	int err;
 	lua_State *L;
+	int hookRefs[LUA_NUM_HOOKS];    ///< registry references of the callbacks, LUA_NOREF if not defined
+
+	// accounting
+	luaCallStats_t stats[LUA_NUM_HOOKS];
+	lua_Alloc allocf;               ///< allocator of the state, G_LuaAlloc forwards to it
+	void *allocud;
+	size_t memUsed;
+	size_t memPeak;
+	int memAllocs;
+	int callDepth;                  ///< nesting of G_LuaCall, the budget is per outermost call
+	int budgetUsed;                 ///< instructions run in the current call, counted budgetStep at a time
+	int budgetStep;                 ///< count of the installed instruction hook, 0 if none
+	qboolean suspended;             ///< exceeded lua_maxInstructions, gets no more callbacks
 } lua_vm_t;
 
 /**
@@ -105,6 +166,7 @@ typedef struct
 } gentity_field_t;
 
 extern lua_vm_t *lVM[LUA_NUM_VM];
+extern int      luaHookVMs[LUA_NUM_HOOKS];
 
 /**
  * @enum printMessageType_e
@@ -127,12 +189,15 @@ typedef struct luaPrintFunctions_s
 {
 	printMessageType_t category;
 	const char *function;
+	luaHook_t hook;
 } luaPrintFunctions_t;
 
 // API
 qboolean G_LuaInit(void);
 qboolean G_LuaCall(lua_vm_t *vm, const char *func, int nargs, int nresults);
 qboolean G_LuaGetNamedFunction(lua_vm_t *vm, const char *name);
+qboolean G_LuaGetHookFunction(lua_vm_t *vm, luaHook_t hook);
+void G_LuaResolveHooks(lua_vm_t *vm);
 qboolean G_LuaStartVM(lua_vm_t *vm);
 qboolean G_LuaRunIsolated(const char *modName);
 void G_LuaStopVM(lua_vm_t *vm);
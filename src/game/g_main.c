@@ -260,6 +260,7 @@ vmCvar_t g_maxWarp;
 #ifdef FEATURE_LUA
 vmCvar_t lua_modules;
 vmCvar_t lua_allowedModules;
+vmCvar_t lua_maxInstructions;
 #endif
 
 vmCvar_t g_guidCheck;
@@ -591,6 +592,7 @@ cvarTable_t gameCvarTable[] =
 #ifdef FEATURE_LUA
 	{ &lua_modules,                       "lua_modules",                       "",                           0,                                               0, qfalse, qfalse },
 	{ &lua_allowedModules,                "lua_allowedModules",                "",                           0,                                               0, qfalse, qfalse },
+	{ &lua_maxInstructions,               "lua_maxInstructions",               "0",                          0,                                               0, qfalse, qfalse },
 #endif
 
 	{ &g_guidCheck,                       "g_guidCheck",                       "1",                          CVAR_ARCHIVE,                                    0, qfalse, qfalse },
@@ -682,6 +684,8 @@ cvarTable_t gameCvarTable[] =
  */
 static int gameCvarTableSize = sizeof(gameCvarTable) / sizeof(gameCvarTable[0]);
 
+static bgCvarChanges_t gameCvarChanges;
+
 /**
  * @var fActions
  * @brief Flag to store executed final auto-actions
@@ -1785,11 +1789,14 @@ void G_RegisterCvars(void)
 
 	G_Printf("%d cvars in use\n", gameCvarTableSize);
 
+	Com_Memset(&gameCvarChanges, 0, sizeof(gameCvarChanges));
+
 	for (i = 0, cv = gameCvarTable; i < gameCvarTableSize; i++, cv++)
 	{
 		trap_Cvar_Register(cv->vmCvar, cv->cvarName, cv->defaultString, cv->cvarFlags);
 		if (cv->vmCvar)
 		{
+			BG_CvarChangesRegister(&gameCvarChanges, i, cv->vmCvar);
 			cv->modificationCount = cv->vmCvar->modificationCount;
 			// update vote info for clients, if necessary
 			G_checkServerToggle(cv->vmCvar);
@@ -1833,7 +1840,8 @@ void G_RegisterCvars(void)
  */
 void G_UpdateCvars(void)
 {
-	int         i;
+	int         i, numChanges;
+	int         changes[ARRAY_LEN(gameCvarTable)];
 	cvarTable_t *cv;
 	qboolean    fToggles           = qfalse;
 	qboolean    fVoteFlags         = qfalse;
@@ -1841,8 +1849,13 @@ void G_UpdateCvars(void)
 	qboolean    clsweaprestriction = qfalse;
 	qboolean    skillLevelPoints   = qfalse;
 
-	for (i = 0, cv = gameCvarTable ; i < gameCvarTableSize ; i++, cv++)
+	// only visit the cvars which changed, if the engine tells us
+	numChanges = BG_CvarChangesGet(&gameCvarChanges, changes, gameCvarTableSize);
+
+	for (i = 0 ; i < numChanges ; i++)
 	{
+		cv = &gameCvarTable[changes[i]];
+
 		if (cv->vmCvar)
 		{
 			trap_Cvar_Update(cv->vmCvar);
@@ -2303,6 +2316,8 @@ void G_InitGame(int levelTime, int randomSeed, int restart, int etLegacyServer,
 	// server version check
 	G_ServerCheck();
 
+	G_InitExtensionTraps();
+
 	G_Printf("------- Game Initialization -------\n");
 	G_Printf("gamename: %s\n", MODNAME);
 	G_Printf("gamedate: %s\n", __DATE__);
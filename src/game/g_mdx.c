@@ -74,6 +74,29 @@ static hit_t *hits     = NULL;
 static int    mdx_bones_max = 0;
 static vec3_t *mdx_bones    = NULL;
 
+/**
+ * @var Pose the whole mdx_bones space was last calculated for
+ */
+static qboolean     mdx_bones_valid = qfalse;
+static grefEntity_t mdx_bones_refent;
+
+#define MDX_POSE_MAX_TAGS 32
+
+/**
+ * @struct mdx_pose_s
+ * @typedef mdx_pose_t
+ * @brief Tag orientations of a client pose, valid for one server frame
+ */
+typedef struct mdx_pose_s
+{
+	int frameNum;
+	grefEntity_t refent;                        ///< pose the tags were lerped for (timeshift included)
+	int tagsValid;                              ///< bit set for each cached tag
+	orientation_t tags[MDX_POSE_MAX_TAGS];
+} mdx_pose_t;
+
+static mdx_pose_t mdx_poses[MAX_CLIENTS];
+
 #define INDEXTOQHANDLE(idx)     (qhandle_t)((idx) + 1)
 /**
   * @var Index may be NULL sometimes, so just default to the first model
@@ -106,7 +129,9 @@ void mdx_cleanup(void)
 
 	mdx_bones_max = 0;
 	Com_Dealloc(mdx_bones);
-	mdx_bones = NULL;
+	mdx_bones       = NULL;
+	mdx_bones_valid = qfalse;
+	Com_Memset(mdx_poses, 0, sizeof(mdx_poses));
 
 #ifdef BONE_HITTESTS
 	cachetag_count = 0;
@@ -234,39 +259,6 @@ static void mdx_quaternion_to_matrix(vec4_t q, vec3_t m[3])
 	m[2][2] = 1 - 2 * (q[0] * q[0] + q[1] * q[1]);
 }
 
-/**
- * @brief mdx_quaternion_nlerp
- * @param[in] q1
- * @param[in] q2
- * @param[out] qout
- * @param[in] backlerp
- */
-static void mdx_quaternion_nlerp(const vec4_t q1, const vec4_t q2, vec4_t qout, float backlerp)
-{
-	float fwdlerp = 1.0 - backlerp;
-	float len;
-
-	qout[0] = q1[0] * backlerp + q2[0] * fwdlerp;
-	qout[1] = q1[1] * backlerp + q2[1] * fwdlerp;
-	qout[2] = q1[2] * backlerp + q2[2] * fwdlerp;
-	qout[3] = q1[3] * backlerp + q2[3] * fwdlerp;
-
-	len = sqrt(qout[0] * qout[0] + qout[1] * qout[1] + qout[2] * qout[2] + qout[3] * qout[3]);
-	if (len)
-	{
-		qout[0] /= len;
-		qout[1] /= len;
-		qout[2] /= len;
-		qout[3] /= len;
-	}
-	else
-	{
-		// very rare -- quaternions pointing in opposite direction with backlerp 0.5
-		// since they're exactly opposite, they're the same rotation :x
-		Vector4Copy(q1, qout);
-	}
-}
-
 /**
  * @brief lerp two rotation matrcies; too lazy to work out how to do it in matrix space.
  * @param[in] m1
@@ -280,7 +272,7 @@ static void mdx_lerp_matrix(vec3_t m1[3], vec3_t m2[3], vec3_t mout[3], float ba
 
 	quat_from_axis(m1, q1);
 	quat_from_axis(m2, q2);
-	mdx_quaternion_nlerp(q1, q2, q, backlerp);
+	quat_nlerp(q1, q2, backlerp, q);
 	mdx_quaternion_to_matrix(q, mout);
 }
 #endif // BONE_HITTESTS
@@ -558,8 +550,9 @@ static void mdx_load(mdx_t *mdxModel, char *mem)
 	if (bone_count > mdx_bones_max)
 	{
 		Com_Dealloc(mdx_bones);
-		mdx_bones_max = bone_count;
-		mdx_bones     = Com_Allocate(mdx_bones_max * sizeof(*mdx_bones));
+		mdx_bones_max   = bone_count;
+		mdx_bones       = Com_Allocate(mdx_bones_max * sizeof(*mdx_bones));
+		mdx_bones_valid = qfalse;
 	}
 
 	// Load bones
@@ -1506,6 +1499,12 @@ static void mdx_calculate_bones(/*const*/ grefEntity_t *refent)
 	mdx_t *torsoFrameModel    = &mdx_models[QHANDLETOINDEX(refent->torsoFrameModel)];
 	mdx_t *oldTorsoFrameModel = &mdx_models[QHANDLETOINDEX_SAFE(refent->oldTorsoFrameModel, refent->torsoFrameModel)];
 
+	// several traces against the same target in a frame share its pose
+	if (mdx_bones_valid && !memcmp(&mdx_bones_refent, refent, sizeof(*refent)))
+	{
+		return;
+	}
+
 #ifdef ETLEGACY_DEBUG
 	if (frameModel->bone_count != torsoFrameModel->bone_count
 	    || frameModel->bone_count != oldFrameModel->bone_count
@@ -1525,6 +1524,9 @@ static void mdx_calculate_bones(/*const*/ grefEntity_t *refent)
 		    qfalse
 		    );
 	}
+
+	mdx_bones_valid  = qtrue;
+	mdx_bones_refent = *refent;
 }
 #endif // BONE_HITTESTS
 
@@ -1541,6 +1543,16 @@ void mdx_calculate_bones_single(/*const*/ grefEntity_t *refent, int i)
 	mdx_t *torsoFrameModel    = &mdx_models[QHANDLETOINDEX(refent->torsoFrameModel)];
 	mdx_t *oldTorsoFrameModel = &mdx_models[QHANDLETOINDEX_SAFE(refent->oldTorsoFrameModel, refent->torsoFrameModel)];
 
+	// the whole pose is already there, including this bone chain
+	if (mdx_bones_valid)
+	{
+		if (!memcmp(&mdx_bones_refent, refent, sizeof(*refent)))
+		{
+			return;
+		}
+		mdx_bones_valid = qfalse;
+	}
+
 #ifdef ETLEGACY_DEBUG
 	if (frameModel->bone_count != torsoFrameModel->bone_count
 	    || frameModel->bone_count != oldFrameModel->bone_count
@@ -1822,6 +1834,51 @@ int trap_R_LerpTag(orientation_t *tag, /*const*/ grefEntity_t *refent, const cha
 	return trap_R_LerpTagNumber(tag, refent, tagNum);
 }
 
+/**
+ * @brief Lerp a tag through the pose cache of the entity
+ *
+ * Hitscan traces rebuild the head and leg boxes of every client for each
+ * shot, the cache keeps the tags of a pose until the frame or the pose
+ * (animation frames, lerp time, angles, origin) changes.
+ *
+ * @param[in] ent entity the pose belongs to, may be NULL
+ * @param[in] refent
+ * @param[in] tagNum
+ * @param[out] tag
+ * @return -1 if the tag is not valid, otherwise 0
+ */
+static int mdx_pose_tag(gentity_t *ent, /*const*/ grefEntity_t *refent, int tagNum, orientation_t *tag)
+{
+	mdx_pose_t *pose;
+
+	if (!ent || ent->s.number >= MAX_CLIENTS || tagNum < 0 || tagNum >= MDX_POSE_MAX_TAGS)
+	{
+		return trap_R_LerpTagNumber(tag, refent, tagNum);
+	}
+
+	pose = &mdx_poses[ent->s.number];
+
+	if (pose->frameNum != level.framenum || memcmp(&pose->refent, refent, sizeof(*refent)))
+	{
+		pose->frameNum  = level.framenum;
+		pose->refent    = *refent;
+		pose->tagsValid = 0;
+	}
+
+	if (!(pose->tagsValid & (1 << tagNum)))
+	{
+		if (trap_R_LerpTagNumber(&pose->tags[tagNum], refent, tagNum) < 0)
+		{
+			return -1;
+		}
+		pose->tagsValid |= (1 << tagNum);
+	}
+
+	*tag = pose->tags[tagNum];
+
+	return 0;
+}
+
 /**************************************************************/
 // Animations/Player stuff
 
@@ -2920,7 +2977,7 @@ qboolean mdx_hit_test(const vec3_t start, const vec3_t end, /*const*/ gentity_t
 
 /**
  * @brief For new old-style hit tests; returns -center- positions, to have -centered- bbox applied.
- * @param ent - unused
+ * @param[in] ent entity the pose is cached for
  * @param[in] refent
  * @param[in,out] org
  */
@@ -2934,7 +2991,7 @@ void mdx_head_position(/*const*/ gentity_t *ent, /*const*/ grefEntity_t *refent,
 
 	model = &mdm_models[QHANDLETOINDEX(refent->hModel)];
 
-	trap_R_LerpTagNumber(&orientation, refent, model->tag_head);
+	mdx_pose_tag(ent, refent, model->tag_head, &orientation);
 
 	// Tag offset
 	VectorCopy(refent->origin, org);
@@ -2953,7 +3010,7 @@ void mdx_head_position(/*const*/ gentity_t *ent, /*const*/ grefEntity_t *refent,
 
 /**
  * @brief Returns tags needed for game, not by Zinx
- * @param ent - unused
+ * @param[in] ent entity the pose is cached for
  * @param[in] refent
  * @param[in,out] org
  * @param[in] tagName
@@ -2966,7 +3023,7 @@ void mdx_tag_position(gentity_t *ent, grefEntity_t *refent, vec3_t org, const ch
 
 	Com_Memset(&orientation, 0, sizeof(orientation));
 
-	trap_R_LerpTag(&orientation, refent, tagName, 0);
+	mdx_pose_tag(ent, refent, trap_R_LookupTag(refent, tagName), &orientation);
 
 	// Tag offset
 	VectorCopy(refent->origin, org);
@@ -2980,7 +3037,7 @@ void mdx_tag_position(gentity_t *ent, grefEntity_t *refent, vec3_t org, const ch
 
 /**
  * @brief mdx_legs_position
- * @param ent - unused
+ * @param[in] ent entity the pose is cached for
  * @param[in] refent
  * @param[out] org
  */
@@ -2994,14 +3051,14 @@ void mdx_legs_position(/*const*/ gentity_t *ent, /*const*/ grefEntity_t *refent,
 
 	model = &mdm_models[QHANDLETOINDEX(refent->hModel)];
 
-	trap_R_LerpTagNumber(&orientation, refent, model->tag_footleft);
+	mdx_pose_tag(ent, refent, model->tag_footleft, &orientation);
 	// Tag offset
 	VectorCopy(refent->origin, org1);
 	VectorMA(org1, orientation.origin[0], refent->axis[0], org1);
 	VectorMA(org1, orientation.origin[1], refent->axis[1], org1);
 	VectorMA(org1, orientation.origin[2], refent->axis[2], org1);
 
-	trap_R_LerpTagNumber(&orientation, refent, model->tag_footright);
+	mdx_pose_tag(ent, refent, model->tag_footright, &orientation);
 	// Tag offset
 	VectorCopy(refent->origin, org2);
 	VectorMA(org2, orientation.origin[0], refent->axis[0], org2);
@@ -266,7 +266,8 @@ typedef enum
 
 #ifndef GAMEDLL
 	// engine extensions
-	G_TRAP_GETVALUE = COM_TRAP_GETVALUE
+	G_TRAP_GETVALUE = COM_TRAP_GETVALUE,
+	G_CVAR_GET_CHANGES,             ///< trap_Cvar_GetChanges_Legacy
 #endif
 
 } gameImport_t;
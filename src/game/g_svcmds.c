@@ -2592,6 +2592,7 @@ static consoleCommandTable_t consoleCommandTable[] =
 	{ "csinfo",                     Svcmd_CSInfo_f                },
 	{ "forceteam",                  Svcmd_ForceTeam_f             },
 	{ "game_memory",                Svcmd_GameMem_f               },
+	{ "antilag_stats",              Svcmd_AntilagStats_f          },
 	{ "addip",                      Svcmd_AddIP_f                 },
 	{ "removeip",                   Svcmd_RemoveIP_f              },
 	{ "listip",                     Svcmd_ListIp_f                },
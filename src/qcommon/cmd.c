@@ -395,6 +395,7 @@ void Cmd_Echo_f(void)
 typedef struct cmd_function_s
 {
 	struct cmd_function_s *next;
+	struct cmd_function_s *hashNext;
 	char *name;
 	char *description;
 	xcommand_t function;
@@ -408,6 +409,10 @@ static char cmd_cmd[BIG_INFO_STRING];                                   ///< the
 
 static cmd_function_t *cmd_functions;                                   ///< possible commands to execute
 
+#define CMD_HASH_SIZE 512
+static cmd_function_t *cmd_hashTable[CMD_HASH_SIZE];                    ///< commands by case insensitive name hash
+#define generateHashValue(fname) Q_GenerateHashValue(fname, CMD_HASH_SIZE, qtrue, qtrue)
+
 /**
  * @brief Cmd_Argc
  * @return
@@ -750,7 +755,7 @@ cmd_function_t *Cmd_FindCommand(const char *cmd_name)
 {
 	cmd_function_t *cmd;
 
-	for (cmd = cmd_functions; cmd; cmd = cmd->next)
+	for (cmd = cmd_hashTable[generateHashValue(cmd_name)]; cmd; cmd = cmd->hashNext)
 	{
 		if (!Q_stricmp(cmd_name, cmd->name))
 		{
@@ -770,6 +775,7 @@ cmd_function_t *Cmd_FindCommand(const char *cmd_name)
 void Cmd_AddSystemCommand(const char *cmd_name, xcommand_t function, const char *description, completionFunc_t complete)
 {
 	cmd_function_t *cmd;
+	long           hash;
 
 	if (!cmd_name || !cmd_name[0])
 	{
@@ -796,6 +802,10 @@ void Cmd_AddSystemCommand(const char *cmd_name, xcommand_t function, const char
 	cmd->next     = cmd_functions;
 	cmd_functions = cmd;
 
+	hash                = generateHashValue(cmd_name);
+	cmd->hashNext       = cmd_hashTable[hash];
+	cmd_hashTable[hash] = cmd;
+
 	if (description && description[0])
 	{
 		cmd->description = CopyString(description);
@@ -813,15 +823,11 @@ void Cmd_AddSystemCommand(const char *cmd_name, xcommand_t function, const char
  */
 void Cmd_SetCommandCompletionFunc(const char *command, completionFunc_t complete)
 {
-	cmd_function_t *cmd;
+	cmd_function_t *cmd = Cmd_FindCommand(command);
 
-	for (cmd = cmd_functions; cmd; cmd = cmd->next)
+	if (cmd)
 	{
-		if (!Q_stricmp(command, cmd->name))
-		{
-			cmd->complete = complete;
-			return;
-		}
+		cmd->complete = complete;
 	}
 }
 
@@ -834,14 +840,11 @@ void Cmd_SetCommandCompletionFunc(const char *command, completionFunc_t complete
  */
 void Cmd_SetCommandDescription(const char *command, const char *description)
 {
-	cmd_function_t *cmd;
+	cmd_function_t *cmd = Cmd_FindCommand(command);
 
-	for (cmd = cmd_functions; cmd; cmd = cmd->next)
+	if (cmd)
 	{
-		if (!Q_stricmp(command, cmd->name))
-		{
-			cmd->description = CopyString(description);
-		}
+		cmd->description = CopyString(description);
 	}
 }
 
@@ -851,7 +854,7 @@ void Cmd_SetCommandDescription(const char *command, const char *description)
  */
 void Cmd_RemoveCommand(const char *cmd_name)
 {
-	cmd_function_t *cmd, **back = &cmd_functions;
+	cmd_function_t *cmd, **back = &cmd_functions, **hashBack;
 
 	if (!cmd_name || !cmd_name[0])
 	{
@@ -871,6 +874,15 @@ void Cmd_RemoveCommand(const char *cmd_name)
 		{
 			*back = cmd->next;
 
+			for (hashBack = &cmd_hashTable[generateHashValue(cmd_name)]; *hashBack; hashBack = &(*hashBack)->hashNext)
+			{
+				if (*hashBack == cmd)
+				{
+					*hashBack = cmd->hashNext;
+					break;
+				}
+			}
+
 			Z_Free(cmd->name);
 
 			if (cmd->description)
@@ -959,18 +971,11 @@ void Cmd_CommandCompletion(void (*callback)(const char *s))
  */
 void Cmd_CompleteArgument(const char *command, char *args, int argNum)
 {
-	cmd_function_t *cmd;
+	cmd_function_t *cmd = Cmd_FindCommand(command);
 
-	for (cmd = cmd_functions; cmd; cmd = cmd->next)
+	if (cmd && cmd->complete)
 	{
-		if (!Q_stricmp(command, cmd->name))
-		{
-			if (cmd->complete)
-			{
-				cmd->complete(args, argNum);
-			}
-			return;
-		}
+		cmd->complete(args, argNum);
 	}
 }
 
@@ -980,7 +985,7 @@ void Cmd_CompleteArgument(const char *command, char *args, int argNum)
  */
 void Cmd_ExecuteString(const char *text)
 {
-	cmd_function_t *cmd, **prev;
+	cmd_function_t *cmd;
 
 	// execute the command line
 	Cmd_TokenizeString(text);
@@ -990,29 +995,13 @@ void Cmd_ExecuteString(const char *text)
 	}
 
 	// check registered command functions
-	for (prev = &cmd_functions ; *prev ; prev = &cmd->next)
+	cmd = Cmd_FindCommand(cmd_argv[0]);
+
+	// perform the action, commands without function are handled by the cgame or game
+	if (cmd && cmd->function)
 	{
-		cmd = *prev;
-		if (!Q_stricmp(cmd_argv[0], cmd->name))
-		{
-			// rearrange the links so that the command will be
-			// near the head of the list next time it is used
-			*prev         = cmd->next;
-			cmd->next     = cmd_functions;
-			cmd_functions = cmd;
-
-			// perform the action
-			if (!cmd->function)
-			{
-				// let the cgame or game handle it
-				break;
-			}
-			else
-			{
-				cmd->function();
-			}
-			return;
-		}
+		cmd->function();
+		return;
 	}
 
 	// check cvars
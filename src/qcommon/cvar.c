@@ -40,10 +40,27 @@ cvar_t *cvar_vars;
 cvar_t *cvar_cheats;
 int    cvar_modifiedFlags;
 
-#define MAX_CVARS   2048
 cvar_t cvar_indexes[MAX_CVARS];
 int    cvar_numIndexes;
 
+/**
+ * @struct cvarChanges_s
+ * @typedef cvarChanges_t
+ * @brief Handles of the cvars a module registered which changed since it last asked,
+ * this saves the module from polling every registered cvar each frame
+ */
+typedef struct cvarChanges_s
+{
+	qboolean active;                            ///< the module fetches its changes, so track them
+	qboolean overflowed;                        ///< more changes than fit, the module has to update all cvars
+	int numChanges;
+	cvarHandle_t changes[MAX_CVAR_CHANGES];
+} cvarChanges_t;
+
+static cvarChanges_t cvar_changes[MAX_VM];
+static byte          cvar_vmRegistered[MAX_CVARS]; ///< bitmask of the modules which registered a cvar
+static byte          cvar_vmChanged[MAX_CVARS];    ///< bitmask of the modules with the cvar already in their change list
+
 #define FILE_HASH_SIZE      512
 static cvar_t *hashTable[FILE_HASH_SIZE];
 #define generateHashValue(fname) Q_GenerateHashValue(fname, FILE_HASH_SIZE, qtrue, qtrue)
@@ -97,6 +114,44 @@ static cvar_t *Cvar_FindVar(const char *var_name)
 	return NULL;
 }
 
+/**
+ * @brief Adds a changed cvar to the change list of every module which registered it
+ * @param[in] var
+ */
+static void Cvar_NotifyChange(cvar_t *var)
+{
+	int           index   = var - cvar_indexes;
+	int           pending = cvar_vmRegistered[index] & ~cvar_vmChanged[index];
+	int           vm;
+	cvarChanges_t *changes;
+
+	if (!pending)
+	{
+		return;
+	}
+
+	for (vm = 0; vm < MAX_VM; vm++)
+	{
+		changes = &cvar_changes[vm];
+
+		if (!(pending & BIT(vm)) || !changes->active)
+		{
+			continue;
+		}
+
+		if (changes->numChanges < MAX_CVAR_CHANGES)
+		{
+			changes->changes[changes->numChanges++] = index;
+		}
+		else
+		{
+			changes->overflowed = qtrue;
+		}
+
+		cvar_vmChanged[index] |= BIT(vm);
+	}
+}
+
 /**
  * @brief Cvar_VariableValue
  * @param[in] var_name
@@ -759,6 +814,7 @@ cvar_t *Cvar_Set2(const char *var_name, const char *value, qboolean force)
 			var->latchedString = CopyString(value);
 			var->modified      = qtrue;
 			var->modificationCount++;
+			Cvar_NotifyChange(var);
 			return var;
 		}
 	}
@@ -778,6 +834,7 @@ cvar_t *Cvar_Set2(const char *var_name, const char *value, qboolean force)
 	}
 	var->modified = qtrue;
 	var->modificationCount++;
+	Cvar_NotifyChange(var);
 
 	Z_Free(var->string);     // free the old value string
 
@@ -1459,6 +1516,9 @@ cvar_t *Cvar_Unset(cvar_t *cv)
 		cv->hashNext->hashPrev = cv->hashPrev;
 	}
 
+	cvar_vmRegistered[cv - cvar_indexes] = 0;
+	cvar_vmChanged[cv - cvar_indexes]    = 0;
+
 	Com_Memset(cv, '\0', sizeof(*cv));
 
 	return next;
@@ -1745,8 +1805,9 @@ void Cvar_SetDescription(cvar_t *cv, const char *varDescription)
  * @param[in] varName
  * @param[in] defaultValue
  * @param[in] flags
+ * @param[in] vm module registering the cvar
  */
-void Cvar_Register(vmCvar_t *vmCvar, const char *varName, const char *defaultValue, int flags)
+void Cvar_Register(vmCvar_t *vmCvar, const char *varName, const char *defaultValue, int flags, vmSlots_t vm)
 {
 	cvar_t *cv;
 
@@ -1835,6 +1896,8 @@ void Cvar_Register(vmCvar_t *vmCvar, const char *varName, const char *defaultVal
 	{
 		return;
 	}
+	cvar_vmRegistered[cv - cvar_indexes] |= BIT(vm);
+
 	vmCvar->handle            = cv - cvar_indexes;
 	vmCvar->modificationCount = -1;
 	Cvar_Update(vmCvar);
@@ -1877,6 +1940,74 @@ void Cvar_Update(vmCvar_t *vmCvar)
 	vmCvar->integer = cv->integer;
 }
 
+/**
+ * @brief Drops all pending change notifications of a module
+ * @param[in] vm
+ */
+static void Cvar_ResetChanges(vmSlots_t vm)
+{
+	int i;
+
+	for (i = 0; i < cvar_numIndexes; i++)
+	{
+		cvar_vmChanged[i] &= ~BIT(vm);
+	}
+
+	cvar_changes[vm].numChanges = 0;
+	cvar_changes[vm].overflowed = qfalse;
+}
+
+/**
+ * @brief Reports the cvars registered by a module which changed since its last call,
+ * so the module only has to update those instead of polling all of its cvars
+ *
+ * @param[in] vm module asking
+ * @param[out] handles changed cvar handles
+ * @param[in] maxHandles size of handles
+ * @return number of changed cvars, or -1 if the module has to update all of its cvars
+ *
+ * @note The first call enables change tracking for the module and always returns -1.
+ */
+int Cvar_GetChanges(vmSlots_t vm, cvarHandle_t *handles, int maxHandles)
+{
+	cvarChanges_t *changes = &cvar_changes[vm];
+	int           i;
+
+	if (!changes->active || changes->overflowed || changes->numChanges > maxHandles)
+	{
+		changes->active = qtrue;
+		Cvar_ResetChanges(vm);
+		return -1;
+	}
+
+	for (i = 0; i < changes->numChanges; i++)
+	{
+		handles[i]                          = changes->changes[i];
+		cvar_vmChanged[changes->changes[i]] &= ~BIT(vm);
+	}
+
+	changes->numChanges = 0;
+
+	return i;
+}
+
+/**
+ * @brief Stops change tracking for a module and forgets its registered cvars
+ * @param[in] vm
+ */
+void Cvar_ClearChanges(vmSlots_t vm)
+{
+	int i;
+
+	for (i = 0; i < cvar_numIndexes; i++)
+	{
+		cvar_vmRegistered[i] &= ~BIT(vm);
+	}
+
+	Cvar_ResetChanges(vm);
+	cvar_changes[vm].active = qfalse;
+}
+
 /**
  * @brief Cvar_CompleteCvarName
  * @param[in] args
@@ -203,6 +203,7 @@ typedef struct fileInPack_s
 	char *name;                         ///< name of the file
 	unsigned long pos;                  ///< file info position in zip
 	unsigned long len;                  ///< uncompress file size
+	unsigned long crc;                  ///< CRC32 of the uncompressed file, from the zip directory
 	struct  fileInPack_s *next;         ///< next file in the hash
 } fileInPack_t;
 
@@ -2458,6 +2459,68 @@ int FS_FileIsInPAK(const char *fileName, int *pChecksum)
 	return -1;
 }
 
+/**
+ * @brief Gets the CRC32 a pak stores for a file without reading the file
+ * @param[in] fileName
+ * @param[out] crc
+ * @return qtrue if the file would be read from a pak, qfalse if it comes from a directory or doesn't exist
+ */
+qboolean FS_FileCRC(const char *fileName, unsigned int *crc)
+{
+	searchpath_t *search;
+	fileInPack_t *pakFile;
+	long         hash;
+
+	if (!fs_searchpaths)
+	{
+		Com_Error(ERR_FATAL, "FS_FileCRC: Filesystem call made without initialization");
+	}
+
+	if (!fileName)
+	{
+		Com_Error(ERR_FATAL, "FS_FileCRC: NULL 'fileName' parameter passed");
+	}
+
+	// qpaths are not supposed to have a leading slash
+	if (fileName[0] == '/' || fileName[0] == '\\')
+	{
+		fileName++;
+	}
+
+	if (strstr(fileName, "..") || strstr(fileName, "::"))
+	{
+		return qfalse;
+	}
+
+	// same order and pure checks as FS_FOpenFileRead
+	for (search = fs_searchpaths ; search ; search = search->next)
+	{
+		if (search->pack)
+		{
+			if (!ALLOW_RAW_FILE_ACCESS && !FS_PakIsPure(search->pack))
+			{
+				continue;
+			}
+
+			hash = FS_HashFileName(fileName, search->pack->hashSize);
+			for (pakFile = search->pack->hashTable[hash]; pakFile; pakFile = pakFile->next)
+			{
+				if (!FS_FilenameCompare(pakFile->name, fileName))
+				{
+					*crc = (unsigned int)pakFile->crc;
+					return qtrue;
+				}
+			}
+		}
+		else if (search->dir && FS_FOpenFileReadDir(fileName, search, NULL, qfalse, qfalse) > 0)
+		{
+			return qfalse;
+		}
+	}
+
+	return qfalse;
+}
+
 /**
  * @brief Open a file relative to the ET:L search path.
  * A null buffer will just return the file length without loading.
@@ -2755,6 +2818,7 @@ static pack_t *FS_LoadZipFile(const char *zipfile, const char *basename)
 		// store the file position in the zip
 		buildBuffer[i].pos    = unzGetOffset(uf);
 		buildBuffer[i].len    = file_info.uncompressed_size;
+		buildBuffer[i].crc    = file_info.crc;
 		buildBuffer[i].next   = pack->hashTable[hash];
 		pack->hashTable[hash] = &buildBuffer[i];
 		unzGoToNextFile(uf);
@@ -50,7 +50,7 @@ extern "C"
 #include <iostream>
 #include <string.h>
 #include <stdlib.h>
-#include <map>
+#include <vector>
 
 #include "../tinygettext/tinygettext/po_parser.hpp"
 #include "../tinygettext/tinygettext/tinygettext.hpp"
@@ -63,11 +63,40 @@ tinygettext::DictionaryManager dictionary_mod;
 cvar_t      *cl_lang = NULL;
 cvar_t      *cl_langDebug = NULL;
 static char cl_lang_last[3];
+static int  cl_lang_modificationCount = -1;
 
 qboolean doTranslate    = qfalse; // we don't translate english in general
 qboolean doTranslateMod = qtrue; // only translate default mod only
 
-std::map <std::string, std::string> strings; // original text / translated text
+/**
+ * @struct i18nString_s
+ * @typedef i18nString_t
+ * @brief Interned translation, the strings stay valid until the language changes
+ */
+typedef struct i18nString_s
+{
+	unsigned int hash;          ///< 0 marks a free slot
+	char *msgid;                ///< original text
+	char *translated;           ///< translated text
+} i18nString_t;
+
+/**
+ * @struct i18nTable_s
+ * @typedef i18nTable_t
+ * @brief Open addressing hash table of the translations of one dictionary
+ */
+typedef struct i18nTable_s
+{
+	std::vector<i18nString_t> strings;
+	unsigned int count;
+} i18nTable_t;
+
+#define I18N_TABLE_SIZE 1024 // initial size, must be a power of two
+
+static i18nTable_t strings;     // client translations
+static i18nTable_t strings_mod; // mod translations
+
+static int i18n_generation = 0; // bumped on each language change
 
 static void TranslationMissing(const char *msgid);
 static void Tinygettext_Error(const std::string& str);
@@ -261,6 +290,25 @@ void I18N_Init(void)
 	FL_FreeLocale(&locale);
 }
 
+/**
+ * @brief Frees the interned strings of a table
+ * @param[in,out] table
+ */
+static void I18N_ClearTable(i18nTable_t &table)
+{
+	for (size_t i = 0; i < table.strings.size(); i++)
+	{
+		if (table.strings[i].hash)
+		{
+			delete[] table.strings[i].msgid;
+			delete[] table.strings[i].translated;
+		}
+	}
+
+	table.strings.clear();
+	table.count = 0;
+}
+
 /**
  * @brief Loads a localization file
  * @param[in] language
@@ -273,6 +321,7 @@ void I18N_SetLanguage(const char *language)
 
 	Com_Printf("Language set to %s\n", dictionary.get_language().get_name().c_str());
 	Com_sprintf(cl_lang_last, sizeof(cl_lang_last), "%s", language);
+	cl_lang_modificationCount = cl_lang->modificationCount;
 
 	if (!Q_stricmp(cl_lang->string, "en"))
 	{
@@ -283,32 +332,155 @@ void I18N_SetLanguage(const char *language)
 		doTranslate = qtrue;
 	}
 
-	strings.clear();
+	// the tables are only rebuilt on language change
+	I18N_ClearTable(strings);
+	I18N_ClearTable(strings_mod);
+
+	i18n_generation++;
+}
+
+/**
+ * @brief Gets the language generation, modules caching translations flush
+ * their cache when it changes
+ * @return
+ */
+int I18N_Generation(void)
+{
+	return i18n_generation;
+}
+
+/**
+ * @brief Hashes a message id, never returns 0 which marks free table slots
+ * @param[in] msgid
+ * @return
+ */
+static unsigned int I18N_HashString(const char *msgid)
+{
+	unsigned int hash = 2166136261u;
+
+	while (*msgid)
+	{
+		hash ^= (unsigned char)*msgid++;
+		hash *= 16777619u;
+	}
+
+	return hash ? hash : 1;
+}
+
+/**
+ * @brief Copies a string for a table, kept out of the small zone as
+ * the dictionary may hold thousands of strings
+ * @param[in] in
+ * @return
+ */
+static char *I18N_CopyString(const char *in)
+{
+	size_t len = strlen(in) + 1;
+	char   *out = new char[len];
+
+	memcpy(out, in, len);
+	return out;
+}
+
+/**
+ * @brief Doubles the size of a table and reinserts its entries
+ * @param[in,out] table
+ */
+static void I18N_GrowTable(i18nTable_t &table)
+{
+	std::vector<i18nString_t> old;
+	unsigned int              size = table.strings.empty() ? I18N_TABLE_SIZE : table.strings.size() * 2;
+	i18nString_t              empty = { 0, NULL, NULL };
+
+	old.swap(table.strings);
+	table.strings.resize(size, empty);
+
+	for (size_t i = 0; i < old.size(); i++)
+	{
+		unsigned int slot;
+
+		if (!old[i].hash)
+		{
+			continue;
+		}
+
+		for (slot = old[i].hash & (size - 1); table.strings[slot].hash; slot = (slot + 1) & (size - 1))
+		{
+		}
+
+		table.strings[slot] = old[i];
+	}
+}
+
+/**
+ * @brief Finds the interned translation of a message id, translating and
+ * inserting it on the first lookup
+ * @param[in,out] table
+ * @param[in] msgid
+ * @param[in] dict
+ * @return
+ */
+static const i18nString_t *I18N_FindString(i18nTable_t &table, const char *msgid, tinygettext::DictionaryManager &dict)
+{
+	unsigned int hash = I18N_HashString(msgid);
+	unsigned int mask, slot;
+
+	// keep the load factor below 3/4 so probe sequences stay short
+	if ((table.count + 1) * 4 > table.strings.size() * 3)
+	{
+		I18N_GrowTable(table);
+	}
+
+	mask = table.strings.size() - 1;
+
+	for (slot = hash & mask; table.strings[slot].hash; slot = (slot + 1) & mask)
+	{
+		if (table.strings[slot].hash == hash && !strcmp(table.strings[slot].msgid, msgid))
+		{
+			return &table.strings[slot];
+		}
+	}
+
+	table.strings[slot].hash       = hash;
+	table.strings[slot].msgid      = I18N_CopyString(msgid);
+	table.strings[slot].translated = I18N_CopyString(dict.get_dictionary().translate(msgid).c_str());
+	table.count++;
+
+	return &table.strings[slot];
 }
 
 /**
  * @brief Translates a string using the specified dictionary
  *
- * Localized strings are stored in a map container as tinygettext would
- * attempt to read them from the po file at each call and would endlessly
+ * Localized strings are interned in a hash table per dictionary as tinygettext
+ * would attempt to read them from the po file at each call and would endlessly
  * spam the console with warnings if the requested translation did not exist.
  *
  * @param[in] msgid original string in English
+ * @param[in,out] table interned strings of the dictionary
  * @param[in] dict dictionary to use (client / mod)
  *
  * @return translated string or English text if dictionary was not found
  */
-static const char *_I18N_Translate(const char *msgid, tinygettext::DictionaryManager &dict)
+static const char *_I18N_Translate(const char *msgid, i18nTable_t &table, tinygettext::DictionaryManager &dict)
 {
+	const i18nString_t *str;
+
 	if (!cl_lang)
 	{
 		Com_DPrintf("Calling translation before I18N is initialized\n");
 		return msgid;
 	}
 
-	if (Q_stricmp(cl_lang->string, cl_lang_last))
+	// only compare the language when the cvar was touched
+	if (cl_lang->modificationCount != cl_lang_modificationCount)
 	{
-		I18N_SetLanguage(cl_lang->string);
+		cl_lang_modificationCount = cl_lang->modificationCount;
+
+		if (Q_stricmp(cl_lang->string, cl_lang_last))
+		{
+			I18N_SetLanguage(cl_lang->string);
+		}
 	}
 
 	if (!doTranslate)
@@ -316,21 +488,17 @@ static const char *_I18N_Translate(const char *msgid, tinygettext::DictionaryMan
 		return msgid;
 	}
 
-	// Store translated string if it is not there yet
-	if (strings.find(msgid) == strings.end())
-	{
-		strings.insert(std::make_pair(msgid, dict.get_dictionary().translate(msgid)));
-	}
+	str = I18N_FindString(table, msgid, dict);
 
 	if (cl_langDebug->integer)
 	{
-		if (!Q_stricmp(strings.find(msgid)->second.c_str(), msgid))
+		if (!Q_stricmp(str->translated, msgid))
 		{
 			TranslationMissing(msgid);
 		}
 	}
 
-	return strings.find(msgid)->second.c_str();
+	return str->translated;
 }
 
 /**
@@ -340,7 +508,7 @@ static const char *_I18N_Translate(const char *msgid, tinygettext::DictionaryMan
  */
 const char *I18N_Translate(const char *msgid)
 {
-	return _I18N_Translate(msgid, dictionary);
+	return _I18N_Translate(msgid, strings, dictionary);
 }
 
 /**
@@ -352,7 +520,7 @@ const char *I18N_TranslateMod(const char *msgid)
 {
 	if (doTranslateMod)
 	{
-		return _I18N_Translate(msgid, dictionary_mod);
+		return _I18N_Translate(msgid, strings_mod, dictionary_mod);
 	}
 	else
 	{
@@ -290,6 +290,67 @@ void MSG_WriteBits(msg_t *msg, int value, int bits)
 	}
 }
 
+/**
+ * @brief Appends bits another message already holds
+ *
+ * The huffman code of a byte doesn't depend on where it is written, so bits
+ * written to a scratch message read back the same from this one. Both
+ * messages have to be bitstreams, not out of band.
+ *
+ * @param[in,out] msg
+ * @param[in] src
+ * @param[in] offset first bit to copy
+ * @param[in] bits
+ */
+void MSG_CopyBits(msg_t *msg, const msg_t *src, int offset, int bits)
+{
+	int value, n, x, y;
+
+	if (msg->overflowed || bits <= 0)
+	{
+		return;
+	}
+
+	if (msg->bit + bits > msg->maxsize << 3)
+	{
+		msg->overflowed = qtrue;
+		return;
+	}
+
+	while (bits > 0)
+	{
+		n = bits < 8 ? bits : 8;
+
+		x     = offset >> 3;
+		y     = offset & 7;
+		value = src->data[x] >> y;
+		if (y + n > 8)
+		{
+			value |= src->data[x + 1] << (8 - y);
+		}
+		value &= (1 << n) - 1;
+
+		// same as Huff_putBit, a byte is cleared when the first bit goes in
+		x = msg->bit >> 3;
+		y = msg->bit & 7;
+		if (!y)
+		{
+			msg->data[x] = 0;
+		}
+		msg->data[x] |= value << y;
+		if (y + n > 8)
+		{
+			msg->data[x + 1] = value >> (8 - y);
+		}
+
+		msg->bit += n;
+		offset   += n;
+		bits     -= n;
+	}
+
+	msg->cursize = (msg->bit >> 3) + 1;
+}
+
 /**
  * @brief MSG_ReadBits
  * @param[in,out] msg
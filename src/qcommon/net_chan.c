@@ -56,9 +56,6 @@ channel matches even if the IP port differs.  The IP port should be updated
 to the new value before sending out any replies.
 */
 
-#define MAX_PACKETLEN           1400        ///< max size of a network packet
-
-#define FRAGMENT_SIZE           (MAX_PACKETLEN - 100)
 #define PACKET_HEADER           10          ///< two ints and a short
 
 #define FRAGMENT_BIT    (1U << 31)
@@ -141,6 +138,7 @@ void Netchan_TransmitNextFragment(netchan_t *chan)
 	// Store send time and size of this packet for rate control
 	chan->lastSentTime = Sys_Milliseconds();
 	chan->lastSentSize = send.cursize;
+	chan->sentBytes   += send.cursize + (chan->remoteAddress.type == NA_IP6 ? UDPIP6_HEADER_SIZE : UDPIP_HEADER_SIZE);
 
 	if (showpackets->integer)
 	{
@@ -215,6 +213,7 @@ void Netchan_Transmit(netchan_t *chan, int length, const byte *data)
 	// Store send time and size of this packet for rate control
 	chan->lastSentTime = Sys_Milliseconds();
 	chan->lastSentSize = send.cursize;
+	chan->sentBytes   += send.cursize + (chan->remoteAddress.type == NA_IP6 ? UDPIP6_HEADER_SIZE : UDPIP_HEADER_SIZE);
 
 	if (showpackets->integer)
 	{
@@ -400,6 +399,80 @@ qboolean Netchan_Process(netchan_t *chan, msg_t *msg)
 	return qtrue;
 }
 
+/**
+ * @brief Obfuscates or restores a netchan payload
+ *
+ * The key is chained through the command string, one character per payload
+ * byte and shifted left on odd offsets, wrapping at the end of the string.
+ * The keystream is built up front so the payload can be XORed a machine word
+ * at a time.
+ *
+ * @param[in,out] data
+ * @param[in] start offset of the first byte to XOR
+ * @param[in] end offset past the last byte to XOR
+ * @param[in] key
+ * @param[in] string command string the key is chained through
+ * @param[in] strip NETCHAN_STRIP_* substitutions applied to the string
+ */
+void Netchan_XorPayload(byte *data, int start, int end, byte key, const byte *string, int strip)
+{
+	static byte command[MAX_MSGLEN];
+	static byte keystream[MAX_MSGLEN];
+	int         count = end - start;
+	int         len, i, index;
+	size_t      word, stream;
+
+	if (count <= 0)
+	{
+		return;
+	}
+
+	// the loop never looks past count characters of the string
+	for (len = 0; len < count && string[len]; len++)
+	{
+		command[len] = string[len];
+
+		if (((strip & NETCHAN_STRIP_HIGH) && command[len] > 127)
+		    || ((strip & NETCHAN_STRIP_PERCENT) && command[len] == '%'))
+		{
+			command[len] = '.';
+		}
+	}
+
+	if (!len)
+	{
+		Com_Memset(keystream, key, count);
+	}
+	else
+	{
+		for (i = 0, index = 0; i < count; i++, index++)
+		{
+			if (index == len)
+			{
+				index = 0;
+			}
+
+			key         ^= command[index] << ((start + i) & 1);
+			keystream[i] = key;
+		}
+	}
+
+	data += start;
+
+	for (i = 0; i + (int)sizeof(word) <= count; i += sizeof(word))
+	{
+		Com_Memcpy(&word, data + i, sizeof(word));
+		Com_Memcpy(&stream, keystream + i, sizeof(word));
+		word ^= stream;
+		Com_Memcpy(data + i, &word, sizeof(word));
+	}
+
+	for ( ; i < count; i++)
+	{
+		data[i] ^= keystream[i];
+	}
+}
+
 //==============================================================================
 
 /**
@@ -35,6 +35,15 @@
 
 #include "q_shared.h"
 
+#if defined(ETL_SIMD_SSE)
+#include <emmintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+#elif defined(ETL_SIMD_NEON)
+#include <arm_neon.h>
+#endif
+
 vec3_t vec3_origin    = { 0, 0, 0 };
 vec3_t axisDefault[3] = { { 1, 0, 0 }, { 0, 1, 0 }, { 0, 0, 1 } };
 
@@ -828,6 +837,38 @@ float Q_fabs(float f)
 }
 #endif
 
+/**
+ * @brief Checks if the SIMD kernels (ETL_SIMD_SSE or ETL_SIMD_NEON) can run on this CPU
+ * @return
+ *
+ * @note The x86 kernels may use anything up to SSE2.
+ */
+qboolean Q_SimdAvailable(void)
+{
+#if defined(__x86_64__) || defined(_M_X64) || defined(ETL_SIMD_NEON)
+	return qtrue;   // part of the base instruction set
+#elif defined(ETL_SIMD_SSE)
+	static int available = -1;
+
+	if (available < 0)
+	{
+#ifdef _MSC_VER
+		int info[4];
+
+		__cpuid(info, 1);
+		available = (info[3] >> 26) & 1;
+#else
+		__builtin_cpu_init();
+		available = __builtin_cpu_supports("sse2") ? 1 : 0;
+#endif
+	}
+
+	return (qboolean)available;
+#else
+	return qfalse;
+#endif
+}
+
 //============================================================
 
 /**
@@ -2521,6 +2562,88 @@ void quat_slerp(const quat_t from, const quat_t to, float frac, quat_t out)
 #endif
 }
 
+#ifdef ETL_SIMD_SSE
+/**
+ * @brief SSE version of quat_nlerp
+ * @param[in] from
+ * @param[in] to
+ * @param[in] backlerp
+ * @param[out] out
+ */
+static ETL_SIMD_TARGET void quat_nlerp_sse(const quat_t from, const quat_t to, float backlerp, quat_t out)
+{
+	__m128 q   = _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(from), _mm_set1_ps(backlerp)), _mm_mul_ps(_mm_loadu_ps(to), _mm_set1_ps(1.0f - backlerp)));
+	__m128 len = _mm_mul_ps(q, q);
+
+	// horizontal add, leaves the sum in every lane
+	len = _mm_add_ps(len, _mm_shuffle_ps(len, len, _MM_SHUFFLE(2, 3, 0, 1)));
+	len = _mm_add_ps(len, _mm_shuffle_ps(len, len, _MM_SHUFFLE(1, 0, 3, 2)));
+
+	if (_mm_cvtss_f32(len) == 0.f)
+	{
+		quat_copy(from, out);
+		return;
+	}
+
+	_mm_storeu_ps(out, _mm_div_ps(q, _mm_sqrt_ps(len)));
+}
+#endif
+
+/**
+ * @brief Normalized linear interpolation of two quaternions
+ * @param[in] from
+ * @param[in] to
+ * @param[in] backlerp fraction of from in the result
+ * @param[out] out
+ *
+ * @note Quaternions pointing in exactly opposite directions with backlerp 0.5 are
+ * the same rotation, from is returned for them.
+ */
+void quat_nlerp(const quat_t from, const quat_t to, float backlerp, quat_t out)
+{
+	float fwdlerp = 1.0f - backlerp;
+	float len;
+
+#if defined(ETL_SIMD_SSE)
+	if (Q_SimdAvailable())
+	{
+		quat_nlerp_sse(from, to, backlerp, out);
+		return;
+	}
+#elif defined(ETL_SIMD_NEON)
+	{
+		float32x4_t q = vmlaq_n_f32(vmulq_n_f32(vld1q_f32(to), fwdlerp), vld1q_f32(from), backlerp);
+
+		len = vaddvq_f32(vmulq_f32(q, q));
+		if (len == 0.f)
+		{
+			quat_copy(from, out);
+			return;
+		}
+
+		vst1q_f32(out, vdivq_f32(q, vdupq_n_f32(sqrtf(len))));
+		return;
+	}
+#endif
+
+	out[0] = from[0] * backlerp + to[0] * fwdlerp;
+	out[1] = from[1] * backlerp + to[1] * fwdlerp;
+	out[2] = from[2] * backlerp + to[2] * fwdlerp;
+	out[3] = from[3] * backlerp + to[3] * fwdlerp;
+
+	len = (float)sqrt((double)(out[0] * out[0] + out[1] * out[1] + out[2] * out[2] + out[3] * out[3]));
+	if (len == 0.f)
+	{
+		quat_copy(from, out);
+		return;
+	}
+
+	out[0] /= len;
+	out[1] /= len;
+	out[2] /= len;
+	out[3] /= len;
+}
+
 /************************************************************************/
 /* Matrix 4                                                             */
 /************************************************************************/
@@ -231,6 +231,8 @@ float Q_fabs(float f);
 float Q_rsqrt(float f);         // reciprocal square root
 #endif
 
+qboolean Q_SimdAvailable(void);
+
 #define SQRTFAST(x) (1.0f / Q_rsqrt(x))
 
 signed char ClampChar(int i);
@@ -331,6 +333,7 @@ void quat_to_vec3_FRU(const quat_t q, vec3_t forward, vec3_t right, vec3_t up);
 void quat_to_axis(const quat_t q, vec3_t axis[3]);
 vec_t quat_norm(quat_t q);
 void quat_slerp(const quat_t from, const quat_t to, float frac, quat_t out);
+void quat_nlerp(const quat_t from, const quat_t to, float backlerp, quat_t out);
 #define quat_set(q, x, y, z, w)  ((q)[0] = (x), (q)[1] = (y), (q)[2] = (z), (q)[3] = (w))
 #define quat_copy(a, b)       ((b)[0] = (a)[0], (b)[1] = (a)[1], (b)[2] = (a)[2], (b)[3] = (a)[3])
 #define quat_compare(a, b)    ((a)[0] == (b)[0] && (a)[1] == (b)[1] && (a)[2] == (b)[2] && (a)[3] == (b)[3])
@@ -105,6 +105,20 @@
 #define ETL_SSE 1
 #endif
 
+// SIMD kernels which are always compiled in and picked at runtime, see Q_SimdAvailable
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define ETL_SIMD_SSE 1
+#if defined(__GNUC__) && !defined(__SSE2__)
+#define ETL_SIMD_TARGET __attribute__((target("sse2")))   // the build targets CPUs without SSE2
+#endif
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#define ETL_SIMD_NEON 1
+#endif
+
+#ifndef ETL_SIMD_TARGET
+#define ETL_SIMD_TARGET
+#endif
+
 #ifdef __GNUC__
 #define _attribute(x) __attribute__(x)
 #else
@@ -981,6 +995,9 @@ typedef struct cvar_s
 
 #define MAX_CVAR_VALUE_STRING   256
 
+#define MAX_CVARS               2048    ///< also the upper bound of a cvarHandle_t
+#define MAX_CVAR_CHANGES        64      ///< changed cvars reported to a module per frame before it has to update all of them
+
 typedef int cvarHandle_t;
 
 /**
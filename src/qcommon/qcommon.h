@@ -80,6 +80,7 @@ struct entityState_s;
 struct playerState_s;
 
 void MSG_WriteBits(msg_t *msg, int value, int bits);
+void MSG_CopyBits(msg_t *msg, const msg_t *src, int offset, int bits);
 
 void MSG_WriteChar(msg_t *msg, int c);
 void MSG_WriteByte(msg_t *msg, int c);
@@ -256,6 +257,12 @@ void NET_Sleep(int msec);
  */
 #define DLTYPE_WWW -1
 
+#define MAX_PACKETLEN           1400        ///< max size of a network packet
+#define FRAGMENT_SIZE           (MAX_PACKETLEN - 100)
+
+#define UDPIP_HEADER_SIZE 28
+#define UDPIP6_HEADER_SIZE 48
+
 /**
  * @struct netchan_t
  *
@@ -288,6 +295,7 @@ typedef struct
 
 	int lastSentTime;
 	int lastSentSize;
+	unsigned int sentBytes;         ///< bytes sent so far including UDP/IP headers, wraps
 } netchan_t;
 
 void Netchan_Init(int port);
@@ -298,6 +306,11 @@ void Netchan_TransmitNextFragment(netchan_t *chan);
 
 qboolean Netchan_Process(netchan_t *chan, msg_t *msg);
 
+#define NETCHAN_STRIP_PERCENT   1       ///< key '%' as '.'
+#define NETCHAN_STRIP_HIGH      2       ///< key chars > 127 as '.'
+
+void Netchan_XorPayload(byte *data, int start, int end, byte key, const byte *string, int strip);
+
 /**
  * @brief download_t
  */
@@ -481,6 +494,17 @@ typedef enum vmSlots_e
 
 extern const char *vmStrs[MAX_VM];
 
+/**
+ * @struct ext_trap_keys_s
+ * @typedef ext_trap_keys_t
+ * @brief Engine extension trap, modules look up its number by name through trap_GetValue
+ */
+typedef struct ext_trap_keys_s
+{
+	const char *name;
+	int trapKey;
+} ext_trap_keys_t;
+
 /**
  * @enum sharedTraps_t
  * @brief
@@ -518,6 +542,8 @@ intptr_t QDECL VM_CallFunc(vm_t *vm, int callNum, ...);
 
 void VM_Debug(int level);
 
+qboolean VM_GetExtensionTrap(const ext_trap_keys_t *traps, char *value, int valueSize, const char *key);
+
 void *VM_ArgPtr(intptr_t intValue);
 void *VM_ExplicitArgPtr(vm_t *vm, intptr_t intValue);
 
@@ -656,12 +682,19 @@ cvar_t *Cvar_GetAndDescribe(const char *varName, const char *value, int flags, c
 // that allows variables to be unarchived without needing bitflags
 // if value is "", the value will not override a previously set value.
 
-void Cvar_Register(vmCvar_t *vmCvar, const char *varName, const char *defaultValue, int flags);
+void Cvar_Register(vmCvar_t *vmCvar, const char *varName, const char *defaultValue, int flags, vmSlots_t vm);
 // basically a slightly modified Cvar_Get for the interpreted modules
 
 void Cvar_Update(vmCvar_t *vmCvar);
 // updates an interpreted modules' version of a cvar
 
+int Cvar_GetChanges(vmSlots_t vm, cvarHandle_t *handles, int maxHandles);
+// fills handles with the cvars registered by a module that changed since the last call
+// returns -1 if the module has to update all of its cvars instead
+
+void Cvar_ClearChanges(vmSlots_t vm);
+// stops change tracking for a module, call when the module is shut down
+
 void Cvar_Set(const char *varName, const char *value);
 // will create the variable with no flags if it doesn't exist
 
@@ -843,6 +876,8 @@ long FS_FOpenFileRead_Filtered(const char *qpath, fileHandle_t *file, qboolean u
 // returns 1 if a file is in the PAK file, otherwise -1
 int FS_FileIsInPAK(const char *fileName, int *pChecksum);
 
+qboolean FS_FileCRC(const char *fileName, unsigned int *crc);
+
 int FS_Delete(const char *fileName);
 
 int FS_Write(const void *buffer, int len, fileHandle_t h);
@@ -1377,6 +1412,8 @@ void Sys_Print(const char *msg);
 // Sys_Milliseconds should only be used for profiling purposes,
 // any game related timing information should come from event timestamps
 int Sys_Milliseconds(void);
+// monotonic clock with microsecond resolution, used for packet pacing
+int64_t Sys_Microseconds(void);
 
 int Sys_PID(void);
 qboolean Sys_WritePIDFile(void);
@@ -1580,6 +1617,7 @@ void I18N_Init(void);
 void I18N_SetLanguage(const char *language);
 const char *I18N_Translate(const char *msgid);
 const char *I18N_TranslateMod(const char *msgid);
+int I18N_Generation(void);
 
 extern qboolean doTranslateMod;
 
@@ -56,6 +56,28 @@ const char *vmStrs[MAX_VM] =
 void VM_VmInfo_f(void);
 void VM_VmProfile_f(void);
 
+/**
+ * @brief Looks up an extension trap number for trap_GetValue
+ * @param[in] traps extension traps of the module, terminated by a NULL name
+ * @param[out] value buffer receiving the trap number
+ * @param[in] valueSize buffer size
+ * @param[in] key to query
+ * @return true if the module asked for a known extension trap
+ */
+qboolean VM_GetExtensionTrap(const ext_trap_keys_t *traps, char *value, int valueSize, const char *key)
+{
+	for (; traps->name; traps++)
+	{
+		if (!Q_stricmp(key, traps->name))
+		{
+			Com_sprintf(value, valueSize, "%i", traps->trapKey);
+			return qtrue;
+		}
+	}
+
+	return qfalse;
+}
+
 /**
  * @brief Converts a VM pointer to a C pointer and
  * checks to make sure that the range is acceptable
@@ -34,6 +34,16 @@
 
 #include "tr_local.h"
 
+#if defined(ETL_SIMD_SSE)
+#include <xmmintrin.h>
+#define MDS_SIMD 1
+typedef __m128 boneColumn_t;
+#elif defined(ETL_SIMD_NEON)
+#include <arm_neon.h>
+#define MDS_SIMD 1
+typedef float32x4_t boneColumn_t;
+#endif
+
 /*
 All bones should be an identity orientation to display the mesh exactly
 as it is specified.
@@ -82,6 +92,9 @@ static qboolean                 isTorso, fullTorso;
 static vec4_t                   m1[4], m2[4];
 static vec3_t                   t;
 static refEntity_t              lastBoneEntity;
+#ifdef MDS_SIMD
+static boneColumn_t boneColumns[MDS_MAX_BONES][4];   ///< bone matrix columns and translation, for skinning 4-wide
+#endif
 
 static int totalrv, totalrt, totalv, totalt;
 
@@ -566,6 +579,83 @@ static ID_INLINE void LocalAddScaledMatrixTransformVector(vec3_t in, float s, ve
 }
 */
 
+#ifdef MDS_SIMD
+/**
+ * @brief Store the columns of the bone matrix and its translation in SIMD registers
+ * @param[in] bone
+ * @param[out] cols
+ */
+static ETL_SIMD_TARGET void LocalBoneColumns(const mdsBoneFrame_t *bone, boneColumn_t cols[4])
+{
+#ifdef ETL_SIMD_SSE
+	cols[0] = _mm_setr_ps(bone->matrix[0][0], bone->matrix[1][0], bone->matrix[2][0], 0.f);
+	cols[1] = _mm_setr_ps(bone->matrix[0][1], bone->matrix[1][1], bone->matrix[2][1], 0.f);
+	cols[2] = _mm_setr_ps(bone->matrix[0][2], bone->matrix[1][2], bone->matrix[2][2], 0.f);
+	cols[3] = _mm_setr_ps(bone->translation[0], bone->translation[1], bone->translation[2], 0.f);
+#else
+	float col[4][4] =
+	{
+		{ bone->matrix[0][0], bone->matrix[1][0], bone->matrix[2][0], 0.f },
+		{ bone->matrix[0][1], bone->matrix[1][1], bone->matrix[2][1], 0.f },
+		{ bone->matrix[0][2], bone->matrix[1][2], bone->matrix[2][2], 0.f },
+		{ bone->translation[0], bone->translation[1], bone->translation[2], 0.f }
+	};
+
+	cols[0] = vld1q_f32(col[0]);
+	cols[1] = vld1q_f32(col[1]);
+	cols[2] = vld1q_f32(col[2]);
+	cols[3] = vld1q_f32(col[3]);
+#endif
+}
+
+/**
+ * @brief SIMD version of the per vertex skinning in RB_SurfaceAnim, the vertex is
+ * transformed by all its weighted bones 4-wide and the normal by the first bone
+ * @param[in] v
+ * @param[out] xyz
+ * @param[out] normal
+ */
+static ETL_SIMD_TARGET void LocalSkinVertex(const mdsVertex_t *v, float *xyz, float *normal)
+{
+	const mdsWeight_t  *w = v->weights;
+	const boneColumn_t *cols;
+	float              out[4];
+	int                k;
+#ifdef ETL_SIMD_SSE
+	__m128 acc = _mm_setzero_ps();
+
+	for (k = 0 ; k < v->numWeights ; k++, w++)
+	{
+		cols = boneColumns[w->boneIndex];
+		acc  = _mm_add_ps(acc, _mm_mul_ps(_mm_set1_ps(w->boneWeight),
+		                                  _mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_set1_ps(w->offset[0]), cols[0]), _mm_mul_ps(_mm_set1_ps(w->offset[1]), cols[1])),
+		                                             _mm_add_ps(_mm_mul_ps(_mm_set1_ps(w->offset[2]), cols[2]), cols[3]))));
+	}
+	_mm_storeu_ps(out, acc);
+	VectorCopy(out, xyz);
+
+	cols = boneColumns[v->weights[0].boneIndex];
+	_mm_storeu_ps(out, _mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_set1_ps(v->normal[0]), cols[0]), _mm_mul_ps(_mm_set1_ps(v->normal[1]), cols[1])),
+	                              _mm_mul_ps(_mm_set1_ps(v->normal[2]), cols[2])));
+	VectorCopy(out, normal);
+#else
+	float32x4_t acc = vdupq_n_f32(0.f);
+
+	for (k = 0 ; k < v->numWeights ; k++, w++)
+	{
+		cols = boneColumns[w->boneIndex];
+		acc  = vmlaq_n_f32(acc, vmlaq_n_f32(vmlaq_n_f32(vmlaq_n_f32(cols[3], cols[0], w->offset[0]), cols[1], w->offset[1]), cols[2], w->offset[2]), w->boneWeight);
+	}
+	vst1q_f32(out, acc);
+	VectorCopy(out, xyz);
+
+	cols = boneColumns[v->weights[0].boneIndex];
+	vst1q_f32(out, vmlaq_n_f32(vmlaq_n_f32(vmulq_n_f32(cols[0], v->normal[0]), cols[1], v->normal[1]), cols[2], v->normal[2]));
+	VectorCopy(out, normal);
+#endif
+}
+#endif
+
 static float LAVangle;
 static float sp, sy, cp, cy;
 
@@ -1489,6 +1579,9 @@ void RB_SurfaceAnim(mdsSurface_t *surface)
 	refEntity_t *refent;
 	int         *boneList;
 	mdsHeader_t *header;
+#ifdef MDS_SIMD
+	qboolean simd;
+#endif
 
 #ifdef DBG_PROFILE_BONES
 	int di = 0, dt, ldt;
@@ -1503,6 +1596,17 @@ void RB_SurfaceAnim(mdsSurface_t *surface)
 
 	R_CalcBones(header, (const refEntity_t *)refent, boneList, surface->numBoneReferences);
 
+#ifdef MDS_SIMD
+	simd = Q_SimdAvailable();
+	if (simd)
+	{
+		for (j = 0; j < surface->numBoneReferences; j++)
+		{
+			LocalBoneColumns(&bones[boneList[j]], boneColumns[boneList[j]]);
+		}
+	}
+#endif
+
 	DBG_SHOWTIME
 
 	// calculate LOD
@@ -1622,16 +1726,25 @@ void RB_SurfaceAnim(mdsSurface_t *surface)
 	{
 		mdsWeight_t *w;
 
-		VectorClear(tempVert);
-
-		w = v->weights;
-		for (k = 0 ; k < v->numWeights ; k++, w++)
+#ifdef MDS_SIMD
+		if (simd)
 		{
-			bone = &bones[w->boneIndex];
-			LocalAddScaledMatrixTransformVectorTranslate(w->offset, w->boneWeight, bone->matrix, bone->translation, tempVert);
+			LocalSkinVertex(v, tempVert, tempNormal);
 		}
+		else
+#endif
+		{
+			VectorClear(tempVert);
 
-		LocalMatrixTransformVector(v->normal, bones[v->weights[0].boneIndex].matrix, tempNormal);
+			w = v->weights;
+			for (k = 0 ; k < v->numWeights ; k++, w++)
+			{
+				bone = &bones[w->boneIndex];
+				LocalAddScaledMatrixTransformVectorTranslate(w->offset, w->boneWeight, bone->matrix, bone->translation, tempVert);
+			}
+
+			LocalMatrixTransformVector(v->normal, bones[v->weights[0].boneIndex].matrix, tempNormal);
+		}
 
 		tess.texCoords[baseVertex + j][0][0] = v->texCoords[0];
 		tess.texCoords[baseVertex + j][0][1] = v->texCoords[1];
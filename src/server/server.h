@@ -117,7 +117,11 @@ typedef struct
 	int timeResidual;                   ///< <= 1000 / sv_frame->value
 	int nextFrameTime;                  ///< when time > nextFrameTime, process world
 	char *configstrings[MAX_CONFIGSTRINGS];
+	int configstringsLength[MAX_CONFIGSTRINGS];
+	int configstringsTotal;             ///< sum of configstringsLength
 	qboolean configstringsmodified[MAX_CONFIGSTRINGS];
+	int configstringsDirty[MAX_CONFIGSTRINGS]; ///< modified indices in the order they changed
+	int numConfigstringsDirty;
 	svEntity_t svEntities[MAX_GENTITIES];
 
 	char *entityParsePoint;             ///< used during game VM init
@@ -194,6 +198,18 @@ typedef enum
 	CS_ACTIVE       ///< client is fully in game
 } clientState_t;
 
+/**
+ * @struct reliableCommand_s
+ * @typedef reliableCommand_t
+ * @brief Server command string shared by the command rings of all clients it
+ * was sent to, freed when the last ring drops it
+ */
+typedef struct reliableCommand_s
+{
+	int refCount;
+	char string[1];                         ///< allocated to fit the command
+} reliableCommand_t;
+
 /**
  * @struct netchan_buffer_s
  * @typedef netchan_buffer_t
@@ -218,7 +234,7 @@ typedef struct client_s
 	char userinfo[MAX_INFO_STRING];         ///< name, etc
 	char userinfobuffer[MAX_INFO_STRING];   ///< used for buffering of user info
 
-	char reliableCommands[MAX_RELIABLE_COMMANDS][MAX_STRING_CHARS];
+	reliableCommand_t *reliableCommands[MAX_RELIABLE_COMMANDS];
 	int reliableSequence;                   ///< last added reliable message, not necesarily sent or acknowledged yet
 	int reliableAcknowledge;                ///< last acknowledged reliable message
 	int reliableSent;                       ///< last sent reliable message, not necesarily acknowledged yet
@@ -274,6 +290,13 @@ typedef struct client_s
 	int ping;
 	int rate;                               ///< bytes / second
 	int snapshotMsec;                       ///< requests a snapshot every snapshotMsec unless rate choked
+	int adaptiveSnapshotMsec;               ///< snapshot interval chosen by sv_adaptiveSnapshots, 0 when unused
+	int adaptiveCheckTime;                  ///< svs.time when adaptiveSnapshotMsec is re-evaluated
+	int rateChokes;                         ///< snapshots held back by rate since the last evaluation
+	int64_t rateTime;                       ///< Sys_Microseconds of the last rate bucket refill, 0 when empty
+	int64_t rateCredit;                     ///< bytes * 1000000 the bucket allows to send, negative while in debt
+	unsigned int rateSentBytes;             ///< netchan.sentBytes already charged to the bucket
+	byte snapshotDeferred[MAX_GENTITIES];   ///< snapshots each entity update was held back by sv_snapshotPriority
 	int pureAuthentic;
 	qboolean gotCP;                         ///< additional flag to distinguish between a bad pure checksum, and no cp command at all
 	netchan_t netchan;
@@ -311,30 +334,32 @@ typedef struct
 
 	float cpu;
 	float avg;
+
+	int netchanQueued;                      ///< messages stacked behind unsent fragments
+	int netchanQueueAllocs;                 ///< queue buffers that weren't taken from the pool
+	int netchanQueueOverflows;              ///< buffers allocated while the client already had messages waiting
 } svstats_t;
 
 /**
  * @def MAX_CHALLENGES
- * @brief Made large to prevent a DoS attack that could
- * cycle all of them out before legitimate users connected
+ * @brief Size of the challenge ping cache, must be a power of two
  */
 #define MAX_CHALLENGES  2048
 
 /**
  * @struct challenge_t
- * @brief
+ * @brief When a challenge cookie was handed out, for the ping checks of its connect
+ *
+ * Challenges themselves are stateless, see SV_ChallengeCookie. An entry is
+ * only needed to measure the ping, it sits in the slot picked by the low bits
+ * of the challenge and may be overwritten by a later one.
  */
 typedef struct
 {
 	netadr_t adr;
 	int challenge;
-	int clientChallenge;    ///< challenge number coming from the client
-	int time;               ///< time the last packet was sent to the autherize server
-	int pingTime;           ///< time the challenge response was sent to client
-	int firstTime;          ///< time the adr was first used
+	int challengeTime;      ///< Sys_Milliseconds when the challenge was sent
 	int firstPing;          ///< Used for min and max ping checks
-	qboolean wasrefused;
-	qboolean connected;
 } challenge_t;
 
 /**
@@ -387,7 +412,8 @@ typedef struct
 	int nextSnapshotEntities;                   ///< next snapshotEntities to use
 	entityState_t *snapshotEntities;            ///< [numSnapshotEntities]
 	int nextHeartbeatTime;
-	challenge_t challenges[MAX_CHALLENGES];     ///< to prevent invalid IPs from connecting
+	challenge_t challenges[MAX_CHALLENGES];     ///< issue times of handed out challenges, indexed by challenge
+	unsigned int challengeSecret[4];            ///< key of the challenge cookies, new every server start
 	receipt_t infoReceipts[MAX_INFO_RECEIPTS];
 	netadr_t redirectAddress;                   ///< for rcon return messages
 	tempBan_t tempBanAddresses[MAX_TEMPBAN_ADDRESSES];
@@ -399,6 +425,9 @@ typedef struct
 	int serverLoad;
 	svstats_t stats;
 
+	netchan_buffer_t *netchanFreeQueue;         ///< sent queue buffers kept for reuse, see NETCHAN_QUEUE_POOL
+	int netchanFreeCount;
+
 	download_t download;
 } serverStatic_t;
 
@@ -445,6 +474,8 @@ extern cvar_t *sv_pure;
 extern cvar_t *sv_floodProtect;
 extern cvar_t *sv_userInfoFloodProtect;
 extern cvar_t *sv_lanForceRate;
+extern cvar_t *sv_adaptiveSnapshots;
+extern cvar_t *sv_snapshotPriority;
 extern cvar_t *sv_onlyVisibleClients;
 
 extern cvar_t *sv_showAverageBPS;           ///< net debugging
@@ -457,6 +488,8 @@ extern cvar_t *sv_wwwBaseURL;  ///< the base URL of all the files
 /// tell clients to perform their downloads while disconnected from the server
 /// this gets you a better throughput, but you loose the ability to control the download usage
 extern cvar_t *sv_wwwDlDisconnected;
+extern cvar_t *sv_httpPort;
+extern cvar_t *sv_httpRate;
 extern cvar_t *sv_wwwFallbackURL;
 
 extern cvar_t *sv_cheats;
@@ -593,14 +626,25 @@ qboolean SV_TempBanIsBanned(netadr_t address);
 void SV_TempBanNetAddress(netadr_t address, int length);
 void SV_UptimeReset(void);
 
-// sv_snapshot.c
 void SV_AddServerCommand(client_t *client, const char *cmd);
+reliableCommand_t *SV_AllocServerCommand(const char *cmd);
+void SV_ReleaseServerCommand(reliableCommand_t *command);
+void SV_AddSharedServerCommand(client_t *client, reliableCommand_t *command);
+const char *SV_GetServerCommand(const client_t *client, int sequence);
+void SV_FreeServerCommands(client_t *client);
+
+// sv_snapshot.c
 void SV_UpdateServerCommandsToClient(client_t *client, msg_t *msg);
 void SV_SendMessageToClient(msg_t *msg, client_t *client);
 void SV_SendClientMessages(void);
 void SV_SendClientSnapshot(client_t *client);
 void SV_CheckClientUserinfoTimer(void);
 void SV_SendClientIdle(client_t *client);
+void SV_NetBench_f(void);
+
+// sv_http.c
+void SV_HTTP_Update(void);
+void SV_HTTP_Shutdown(void);
 
 // sv_game.c
 int SV_NumForGentity(sharedEntity_t *ent);
@@ -683,6 +727,7 @@ void SV_ClipToEntity(trace_t *trace, const vec3_t start, const vec3_t mins, cons
 // sv_net_chan.c
 void SV_Netchan_Transmit(client_t *client, msg_t *msg);
 void SV_Netchan_ClearQueue(client_t *client);
+void SV_Netchan_FreePool(void);
 int SV_Netchan_TransmitNextFragment(client_t *client);
 qboolean SV_Netchan_Process(client_t *client, msg_t *msg);
 
@@ -561,8 +561,6 @@ void SV_BotInitBotLib(void)
 int SV_BotGetConsoleMessage(int client, char *buf, size_t size)
 {
 	client_t *cl = &svs.clients[client];
-	int      index;
-
 	cl->lastPacketTime = svs.time;
 
 	if (cl->reliableAcknowledge == cl->reliableSequence)
@@ -571,13 +569,12 @@ int SV_BotGetConsoleMessage(int client, char *buf, size_t size)
 	}
 
 	cl->reliableAcknowledge++;
-	index = cl->reliableAcknowledge & (MAX_RELIABLE_COMMANDS - 1);
 
-	if (!cl->reliableCommands[index][0])
+	if (!SV_GetServerCommand(cl, cl->reliableAcknowledge)[0])
 	{
 		return qfalse;
 	}
 
-	//Q_strncpyz( buf, cl->reliableCommands[index], size );
+	//Q_strncpyz( buf, SV_GetServerCommand(cl, cl->reliableAcknowledge), size );
 	return qtrue;
 }
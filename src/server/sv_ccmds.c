@@ -473,6 +473,7 @@ static void SV_Status_f(void)
 	Com_Printf("avg response time     : %i ms\n", ( int ) svs.stats.avg);
 	Com_Printf("server time           : %i\n", svs.time);
 	Com_Printf("internal time         : %i\n", Sys_Milliseconds());
+	Com_Printf("netchan queue         : %i queued, %i allocated, %i overflowed\n", svs.stats.netchanQueued, svs.stats.netchanQueueAllocs, svs.stats.netchanQueueOverflows);
 	Com_Printf("map                   : %s\n\n", sv_mapname->string);
 	Com_Printf("num score ping name                                lastmsg address               qport rate  lastConnectTime\n");
 	Com_Printf("--- ----- ---- ----------------------------------- ------- --------------------- ----- ----- ---------------\n");
@@ -717,6 +718,7 @@ void SV_AddOperatorCommands(void)
 	}
 
 	Cmd_AddCommand("uptime", SV_Uptime_f, "Prints uptime info.");
+	Cmd_AddCommand("netbench", SV_NetBench_f, "Times snapshot generation for the active clients and fake clients, netbench [iterations] [fakeclients].");
 
 #if defined(FEATURE_IRC_SERVER) && defined(DEDICATED)
 	Cmd_AddCommand("irc_connect", IRC_Connect, "Connects to an IRC server.");
@@ -37,6 +37,122 @@
 
 static void SV_CloseDownload(client_t *cl);
 
+#define CHALLENGE_BUCKET_SHIFT  15      // cookies are keyed to ~33 sec time buckets
+
+#define SIPROUND(v0, v1, v2, v3) \
+	do { \
+		v0 += v1; v1 = (v1 << 13) | (v1 >> 51); v1 ^= v0; v0 = (v0 << 32) | (v0 >> 32); \
+		v2 += v3; v3 = (v3 << 16) | (v3 >> 48); v3 ^= v2; \
+		v0 += v3; v3 = (v3 << 21) | (v3 >> 43); v3 ^= v0; \
+		v2 += v1; v1 = (v1 << 17) | (v1 >> 47); v1 ^= v2; v2 = (v2 << 32) | (v2 >> 32); \
+	} while (0)
+
+/**
+ * @brief SipHash-2-4 of a buffer, a keyed hash which can't be forged without the key
+ * @param[in] key
+ * @param[in] data
+ * @param[in] len
+ * @return
+ */
+static uint64_t SV_SipHash(const unsigned int key[4], const byte *data, int len)
+{
+	uint64_t k0 = key[0] | ((uint64_t)key[1] << 32);
+	uint64_t k1 = key[2] | ((uint64_t)key[3] << 32);
+	uint64_t v0 = k0 ^ 0x736f6d6570736575ULL;
+	uint64_t v1 = k1 ^ 0x646f72616e646f6dULL;
+	uint64_t v2 = k0 ^ 0x6c7967656e657261ULL;
+	uint64_t v3 = k1 ^ 0x7465646279746573ULL;
+	uint64_t m;
+	int      i, left = len & 7;
+
+	for (i = 0; i < len - left; i += 8)
+	{
+		m = (uint64_t)data[i] | ((uint64_t)data[i + 1] << 8) | ((uint64_t)data[i + 2] << 16) | ((uint64_t)data[i + 3] << 24)
+		    | ((uint64_t)data[i + 4] << 32) | ((uint64_t)data[i + 5] << 40) | ((uint64_t)data[i + 6] << 48) | ((uint64_t)data[i + 7] << 56);
+
+		v3 ^= m;
+		SIPROUND(v0, v1, v2, v3);
+		SIPROUND(v0, v1, v2, v3);
+		v0 ^= m;
+	}
+
+	// the last block carries the length in its top byte
+	m = (uint64_t)len << 56;
+	while (left--)
+	{
+		m |= (uint64_t)data[i + left] << (8 * left);
+	}
+
+	v3 ^= m;
+	SIPROUND(v0, v1, v2, v3);
+	SIPROUND(v0, v1, v2, v3);
+	v0 ^= m;
+
+	v2 ^= 0xff;
+	SIPROUND(v0, v1, v2, v3);
+	SIPROUND(v0, v1, v2, v3);
+	SIPROUND(v0, v1, v2, v3);
+	SIPROUND(v0, v1, v2, v3);
+
+	return v0 ^ v1 ^ v2 ^ v3;
+}
+
+/**
+ * @brief Computes the challenge cookie of an address
+ *
+ * The cookie is a SipHash keyed by svs.challengeSecret of the address and a
+ * time bucket, so a connect can be checked without keeping anything per
+ * address. Only whoever receives packets sent to the address learns its
+ * cookie, forging one takes about 2^31 guesses.
+ *
+ * @param[in] from
+ * @param[in] bucket
+ *
+ * @return A positive challenge number
+ */
+static int SV_ChallengeCookie(netadr_t from, int bucket)
+{
+	byte key[24];
+	int  challenge;
+
+	Com_Memset(key, 0, sizeof(key));
+	if (from.type == NA_IP6)
+	{
+		Com_Memcpy(key, from.ip6, sizeof(from.ip6));
+	}
+	else
+	{
+		Com_Memcpy(key, from.ip, sizeof(from.ip));
+	}
+	key[16] = (byte)from.type;
+	key[17] = (byte)(from.port & 0xff);
+	key[18] = (byte)(from.port >> 8);
+	key[20] = (byte)(bucket & 0xff);
+	key[21] = (byte)((bucket >> 8) & 0xff);
+	key[22] = (byte)((bucket >> 16) & 0xff);
+	key[23] = (byte)((bucket >> 24) & 0xff);
+
+	challenge = (int)(SV_SipHash(svs.challengeSecret, key, sizeof(key)) & 0x7fffffff);
+
+	return challenge ? challenge : 1;
+}
+
+/**
+ * @brief Checks a challenge cookie presented by an address
+ *
+ * @param[in] from
+ * @param[in] challenge
+ *
+ * @return qtrue if the challenge was issued to this address in the current
+ *         or the previous time bucket
+ */
+static qboolean SV_CheckChallengeCookie(netadr_t from, int challenge)
+{
+	int bucket = Sys_Milliseconds() >> CHALLENGE_BUCKET_SHIFT;
+
+	return challenge == SV_ChallengeCookie(from, bucket) || challenge == SV_ChallengeCookie(from, bucket - 1);
+}
+
 /**
  * @brief A "getchallenge" OOB command has been received
  *
@@ -48,13 +164,14 @@ static void SV_CloseDownload(client_t *cl);
  * We do this to prevent denial of service attacks that flood
  * the server with invalid connection IPs. With a challenge,
  * they must give a valid IP address.
+ *
+ * The challenge is a stateless cookie, so a getchallenge flood from spoofed
+ * addresses costs a hash per packet and can't push real players out.
  */
 void SV_GetChallenge(netadr_t from)
 {
-	int         i;
-	int         oldest;
-	int         oldestTime;
-	challenge_t *challenge;
+	int         now, challenge;
+	challenge_t *entry;
 
 	if (SV_TempBanIsBanned(from))
 	{
@@ -81,50 +198,27 @@ void SV_GetChallenge(netadr_t from)
 		}
 	}
 
-	oldest     = 0;
-	oldestTime = 0x7fffffff;
-
-	// see if we already have a challenge for this ip
-	challenge = &svs.challenges[0];
-	for (i = 0 ; i < MAX_CHALLENGES ; i++, challenge++)
-	{
-		if (!challenge->connected && NET_CompareAdr(from, challenge->adr))
-		{
-			break;
-		}
-		if (challenge->time < oldestTime)
-		{
-			oldestTime = challenge->time;
-			oldest     = i;
-		}
-	}
-
-	if (i == MAX_CHALLENGES)
-	{
-		// this is the first time this client has asked for a challenge
-		challenge = &svs.challenges[oldest];
+	// FIXME: deal with restricted filesystem - done with sv_pure check ?
 
-		challenge->challenge = (((unsigned int) rand() << 16) ^ (unsigned int)rand()) ^ svs.time;
-		challenge->adr       = from;
-		challenge->firstTime = svs.time;
-		challenge->firstPing = 0;
-		challenge->time      = svs.time;
-		challenge->connected = qfalse;
-	}
+	now       = Sys_Milliseconds();
+	challenge = SV_ChallengeCookie(from, now >> CHALLENGE_BUCKET_SHIFT);
 
-	// FIXME: deal with restricted filesystem - done with sv_pure check ?
+	// remember when it was handed out for the ping checks, losing the entry to
+	// a flood only loses the ping, not the challenge
+	entry                = &svs.challenges[challenge & (MAX_CHALLENGES - 1)];
+	entry->adr           = from;
+	entry->challenge     = challenge;
+	entry->challengeTime = now;
+	entry->firstPing     = 0;
 
-	challenge->pingTime = svs.time;
 	if (sv_onlyVisibleClients->integer)
 	{
-		NET_OutOfBandPrint(NS_SERVER, from, "challengeResponse %i %i", challenge->challenge, sv_onlyVisibleClients->integer);
+		NET_OutOfBandPrint(NS_SERVER, from, "challengeResponse %i %i", challenge, sv_onlyVisibleClients->integer);
 	}
 	else
 	{
-		NET_OutOfBandPrint(NS_SERVER, from, "challengeResponse %i", challenge->challenge);
+		NET_OutOfBandPrint(NS_SERVER, from, "challengeResponse %i", challenge);
 	}
-
-	return;
 }
 
 /**
@@ -359,19 +453,10 @@ void SV_DirectConnect(netadr_t from)
 	// see if the challenge is valid (local clients don't need to challenge)
 	if (!NET_IsLocalAddress(from))
 	{
-		int ping;
+		int         ping;
+		challenge_t *entry;
 
-		for (i = 0 ; i < MAX_CHALLENGES ; i++)
-		{
-			if (NET_CompareAdr(from, svs.challenges[i].adr))
-			{
-				if (challenge == svs.challenges[i].challenge)
-				{
-					break;      // good
-				}
-			}
-		}
-		if (i == MAX_CHALLENGES)
+		if (!SV_CheckChallengeCookie(from, challenge))
 		{
 			NET_OutOfBandPrint(NS_SERVER, from, "print\n[err_dialog]No or bad challenge for address.\n");
 			return;
@@ -379,21 +464,28 @@ void SV_DirectConnect(netadr_t from)
 		// force the IP key/value pair so the game can filter based on ip
 		Info_SetValueForKey(userinfo, "ip", NET_AdrToString(from));
 
-		if (svs.challenges[i].firstPing == 0)
+		// a retried connect keeps the ping of the first one
+		i     = challenge & (MAX_CHALLENGES - 1);
+		entry = &svs.challenges[i];
+		if (entry->challenge == challenge && NET_CompareAdr(from, entry->adr))
 		{
-			ping                        = svs.time - svs.challenges[i].pingTime;
-			svs.challenges[i].firstPing = ping;
+			if (!entry->firstPing)
+			{
+				entry->firstPing = MAX(Sys_Milliseconds() - entry->challengeTime, 1);
+			}
+			ping = entry->firstPing;
 		}
 		else
 		{
-			ping = svs.challenges[i].firstPing;
+			// the entry was taken by another challenge, the cookie is still
+			// valid but when it was handed out isn't known anymore
+			ping = -1;
 		}
 
 		Com_Printf("Client %i connecting with %i challenge ping\n", i, ping);
-		svs.challenges[i].connected = qtrue;
 
 		// never reject a LAN client based on ping
-		if (!Sys_IsLANAddress(from))
+		if (!Sys_IsLANAddress(from) && ping >= 0)
 		{
 			if (sv_minPing->value != 0.f && ping < sv_minPing->value)
 			{
@@ -518,6 +610,8 @@ gotnewcl:
 	// build a new connection
 	// accept the new client
 	// this is the only place a client_t is EVER initialized
+	SV_FreeServerCommands(newcl);
+	SV_Netchan_ClearQueue(newcl);
 	*newcl         = temp;
 	clientNum      = newcl - svs.clients;
 	newcl->gentity = SV_GentityNum(clientNum);
@@ -556,8 +650,11 @@ gotnewcl:
 
 	SV_UserinfoChanged(newcl);
 
-	// Clear out firstPing now that client is connected
-	svs.challenges[i].firstPing = 0;
+	// Clear out the ping entry now that client is connected
+	if (!NET_IsLocalAddress(from))
+	{
+		Com_Memset(&svs.challenges[challenge & (MAX_CHALLENGES - 1)], 0, sizeof(challenge_t));
+	}
 
 	// send the connect packet to the client
 	NET_OutOfBandPrint(NS_SERVER, from, "connectResponse");
@@ -628,9 +725,8 @@ qboolean SV_CheckForMsgOverflow(client_t *client, msg_t *msg)
  */
 void SV_DropClient(client_t *drop, const char *reason)
 {
-	int         i;
-	challenge_t *challenge;
-	qboolean    isBot = qfalse;
+	int      i;
+	qboolean isBot = qfalse;
 
 	if (drop->state == CS_ZOMBIE)
 	{
@@ -652,18 +748,6 @@ void SV_DropClient(client_t *drop, const char *reason)
 	// Don't drop bots nor democlients (will make the server crash since there's no network connection to manage with these clients!)
 	if (!isBot && !drop->demoClient)
 	{
-		// see if we already have a challenge for this ip
-		challenge = &svs.challenges[0];
-
-		for (i = 0 ; i < MAX_CHALLENGES ; i++, challenge++)
-		{
-			if (NET_CompareAdr(drop->netchan.remoteAddress, challenge->adr))
-			{
-				challenge->connected = qfalse;
-				break;
-			}
-		}
-
 		SV_Netchan_ClearQueue(drop);
 	}
 
@@ -1385,11 +1469,20 @@ static qboolean SV_WriteDownloadToClient(client_t *cl, msg_t *msg)
  */
 int SV_SendQueuedMessages(void)
 {
-	int      i, retval = -1, nextFragT;
-	client_t *cl;
+	int        i, n, retval = -1, nextFragT;
+	client_t   *cl;
+	static int first = 0;
 
-	for (i = 0; i < sv_maxclients->integer; i++)
+	// start each round with another client, so the low slots don't
+	// always get their fragments out first when many clients have data pending
+	if (first >= sv_maxclients->integer)
 	{
+		first = 0;
+	}
+
+	for (n = 0; n < sv_maxclients->integer; n++)
+	{
+		i  = (first + n) % sv_maxclients->integer;
 		cl = &svs.clients[i];
 
 		if (cl->state)
@@ -1408,6 +1501,8 @@ int SV_SendQueuedMessages(void)
 		}
 	}
 
+	first++;
+
 	return retval;
 }
 
@@ -2042,7 +2137,7 @@ static void SV_UserMove(client_t *cl, msg_t *msg, qboolean delta)
 	// also use the message acknowledge
 	key ^= cl->messageAcknowledge;
 	// also use the last acknowledged server command in the key
-	key ^= MSG_HashKey(cl->reliableCommands[cl->reliableAcknowledge & (MAX_RELIABLE_COMMANDS - 1)], 32, !Com_IsCompatible(&cl->agent, 0x1));
+	key ^= MSG_HashKey(SV_GetServerCommand(cl, cl->reliableAcknowledge), 32, !Com_IsCompatible(&cl->agent, 0x1));
 
 	Com_Memset(&nullcmd, 0, sizeof(nullcmd));
 	oldcmd = &nullcmd;
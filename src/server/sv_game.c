@@ -427,7 +427,13 @@ static int FloatAsInt(float f)
  */
 static qboolean SV_G_GetValue(char *value, int valueSize, const char *key)
 {
-	return qfalse;
+	static const ext_trap_keys_t g_extensionTraps[] =
+	{
+		{ "trap_Cvar_GetChanges_Legacy", G_CVAR_GET_CHANGES },
+		{ NULL,                          -1                 }
+	};
+
+	return VM_GetExtensionTrap(g_extensionTraps, value, valueSize, key);
 }
 
 extern int S_RegisterSound(const char *name, qboolean compressed);
@@ -451,7 +457,7 @@ intptr_t SV_GameSystemCalls(intptr_t *args)
 	case G_MILLISECONDS:
 		return Sys_Milliseconds();
 	case G_CVAR_REGISTER:
-		Cvar_Register(VMA(1), VMA(2), VMA(3), args[4]);
+		Cvar_Register(VMA(1), VMA(2), VMA(3), args[4], VM_GAME);
 		return 0;
 	case G_CVAR_UPDATE:
 		Cvar_Update(VMA(1));
@@ -696,6 +702,8 @@ intptr_t SV_GameSystemCalls(intptr_t *args)
 
 	case G_TRAP_GETVALUE:
 		return SV_G_GetValue(VMA(1), args[2], VMA(3));
+	case G_CVAR_GET_CHANGES:
+		return Cvar_GetChanges(VM_GAME, VMA(1), args[2]);
 
 	default:
 		Com_Error(ERR_DROP, "Bad game system trap: %ld", (long int) args[0]);
@@ -722,6 +730,7 @@ void SV_ShutdownGameProgs(void)
 	VM_Call(gvm, GAME_SHUTDOWN, qfalse);
 	VM_Free(gvm);
 	gvm = NULL;
+	Cvar_ClearChanges(VM_GAME);
 }
 
 /**
@@ -765,6 +774,7 @@ void SV_RestartGameProgs(void)
 		return;
 	}
 	VM_Call(gvm, GAME_SHUTDOWN, qtrue);
+	Cvar_ClearChanges(VM_GAME);
 
 	// do a restart instead of a free
 	gvm = VM_Restart(gvm);
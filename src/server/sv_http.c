@@ -0,0 +1,1089 @@
+/*
+ * ET: Legacy
+ * Copyright (C) 2012-2018 ET:Legacy team <mail@etlegacy.com>
+ *
+ * This file is part of ET: Legacy - http://www.etlegacy.com
+ *
+ * ET: Legacy is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ET: Legacy is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with ET: Legacy. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * In addition, Wolfenstein: Enemy Territory GPL Source Code is also
+ * subject to certain additional terms. You should have received a copy
+ * of these additional terms immediately following the terms and conditions
+ * of the GNU General Public License which accompanied the source code.
+ * If not, please request a copy in writing from id Software at the address below.
+ *
+ * id Software LLC, c/o ZeniMax Media Inc., Suite 120, Rockville, Maryland 20850 USA.
+ */
+/**
+ * @file sv_http.c
+ * @brief Built-in HTTP server for pk3 downloads
+ *
+ * Serves the packages clients may download (sv_referencedPakNames without the
+ * official ones) from its own thread, so www downloads never touch the game
+ * frame. Set sv_httpPort and point sv_wwwBaseURL at http://<address>:<port>,
+ * the redirect in SV_SetupDownloadFile then sends clients here.
+ *
+ * The thread doesn't use the filesystem or the console, the main thread
+ * hands it a table of file names and paths in SV_HTTP_Update.
+ *
+ * Listens on IPv4, and on IPv6 too with FEATURE_IPV6.
+ */
+
+#include "server.h"
+
+#ifdef _WIN32
+#   include <winsock2.h>
+#   include <ws2tcpip.h>
+
+typedef int socklen_t;
+#   define socketError          WSAGetLastError()
+#   define SOCKET_WOULDBLOCK    WSAEWOULDBLOCK
+#else
+#   include <sys/socket.h>
+#   include <sys/types.h>
+#   include <sys/time.h>
+#   include <sys/ioctl.h>
+#   include <netinet/in.h>
+#   include <unistd.h>
+#   include <errno.h>
+#   include <signal.h>
+#   include <pthread.h>
+#   ifdef __linux__
+#       include <sys/sendfile.h>
+#   endif
+
+typedef int SOCKET;
+#   define INVALID_SOCKET       -1
+#   define SOCKET_ERROR         -1
+#   define closesocket          close
+#   define ioctlsocket          ioctl
+#   define socketError          errno
+#   define SOCKET_WOULDBLOCK    EAGAIN
+#endif
+
+#ifndef MSG_NOSIGNAL
+#   define MSG_NOSIGNAL 0
+#endif
+
+#define HTTP_MAX_CONNECTIONS    32
+#define HTTP_MAX_FILES          256
+#define HTTP_BUFFER_SIZE        2048
+#define HTTP_CHUNK_SIZE         65536   ///< most bytes handed to the socket at once
+#define HTTP_TIMEOUT            30000   ///< msec a connection may stall
+#define HTTP_REQUEST_TIMEOUT    10000   ///< msec from accept to the end of the request headers
+#define HTTP_MAX_PER_ADDRESS    4       ///< connections one client address may hold
+#define HTTP_SELECT_USEC        10000   ///< how often rate limited connections are served
+
+/**
+ * @struct httpFile_t
+ * @brief A file the server hands out
+ */
+typedef struct
+{
+	char name[MAX_QPATH];               ///< path in the URL, as in cl->downloadName
+	char path[MAX_OSPATH];
+	long size;
+} httpFile_t;
+
+/**
+ * @struct httpConnection_t
+ * @brief A client connection, closed after one response
+ */
+typedef struct
+{
+	SOCKET sock;
+	FILE *file;
+	char buffer[HTTP_BUFFER_SIZE];      ///< request while reading it, response header while sending it
+	int length;
+	int sent;
+	qboolean responding;
+	long offset;                        ///< next file byte to send
+	long end;                           ///< file offset to stop at
+	int64_t credit;                     ///< bytes * 1000000 the rate allows to send
+	int64_t lastTime;
+	int lastActivity;
+	int acceptTime;
+	byte address[16];                   ///< of the client, IPv4 mapped into IPv6
+} httpConnection_t;
+
+static httpFile_t       http_files[HTTP_MAX_FILES];
+static int              http_numFiles;
+static httpConnection_t http_connections[HTTP_MAX_CONNECTIONS];
+static SOCKET           http_socket = INVALID_SOCKET;
+static SOCKET           http_socket6 = INVALID_SOCKET;
+static int              http_port;
+static volatile int     http_rate;      ///< bytes / second per connection, 0 for no limit
+static volatile qboolean http_quit;
+static qboolean         http_running;
+
+/*
+ * Caution: SV_HTTP_SystemThreadProc(), SV_HTTP_StartThread(), SV_HTTP_WaitThread()
+ * and the lock have separate "VARIANTS", see irc_client.c.
+ */
+#ifdef _WIN32
+
+/****** THREAD HANDLING - WINDOWS VARIANT ******/
+
+static HANDLE           http_thread = NULL;
+static CRITICAL_SECTION http_lock;
+
+static void SV_HTTP_Thread(void);
+
+/**
+ * @brief SV_HTTP_SystemThreadProc
+ * @param dummy - unused
+ * @return
+ */
+static DWORD WINAPI SV_HTTP_SystemThreadProc(LPVOID dummy)
+{
+	SV_HTTP_Thread();
+	return 0;
+}
+
+/**
+ * @brief SV_HTTP_StartThread
+ * @return qfalse if the thread couldn't be created
+ */
+static qboolean SV_HTTP_StartThread(void)
+{
+	InitializeCriticalSection(&http_lock);
+	http_thread = CreateThread(NULL, 0, SV_HTTP_SystemThreadProc, NULL, 0, NULL);
+	if (http_thread == NULL)
+	{
+		DeleteCriticalSection(&http_lock);
+		return qfalse;
+	}
+	return qtrue;
+}
+
+/**
+ * @brief SV_HTTP_WaitThread
+ */
+static void SV_HTTP_WaitThread(void)
+{
+	WaitForSingleObject(http_thread, INFINITE);
+	CloseHandle(http_thread);
+	http_thread = NULL;
+	DeleteCriticalSection(&http_lock);
+}
+
+/**
+ * @brief SV_HTTP_Lock
+ */
+static void SV_HTTP_Lock(void)
+{
+	EnterCriticalSection(&http_lock);
+}
+
+/**
+ * @brief SV_HTTP_Unlock
+ */
+static void SV_HTTP_Unlock(void)
+{
+	LeaveCriticalSection(&http_lock);
+}
+
+#else
+
+/****** THREAD HANDLING - UNIX VARIANT ******/
+
+static pthread_t       http_thread;
+static pthread_mutex_t http_lock = PTHREAD_MUTEX_INITIALIZER;
+
+static void SV_HTTP_Thread(void);
+
+/**
+ * @brief SV_HTTP_SystemThreadProc
+ * @param dummy - unused
+ * @return
+ */
+static void *SV_HTTP_SystemThreadProc(void *dummy)
+{
+	sigset_t set;
+
+	// a client hanging up mid transfer must not kill the server
+	sigemptyset(&set);
+	sigaddset(&set, SIGPIPE);
+	pthread_sigmask(SIG_BLOCK, &set, NULL);
+
+	SV_HTTP_Thread();
+	return NULL;
+}
+
+/**
+ * @brief SV_HTTP_StartThread
+ * @return qfalse if the thread couldn't be created
+ */
+static qboolean SV_HTTP_StartThread(void)
+{
+	return pthread_create(&http_thread, NULL, SV_HTTP_SystemThreadProc, NULL) == 0;
+}
+
+/**
+ * @brief SV_HTTP_WaitThread
+ */
+static void SV_HTTP_WaitThread(void)
+{
+	pthread_join(http_thread, NULL);
+}
+
+/**
+ * @brief SV_HTTP_Lock
+ */
+static void SV_HTTP_Lock(void)
+{
+	pthread_mutex_lock(&http_lock);
+}
+
+/**
+ * @brief SV_HTTP_Unlock
+ */
+static void SV_HTTP_Unlock(void)
+{
+	pthread_mutex_unlock(&http_lock);
+}
+
+#endif
+
+/**
+ * @brief Looks up a file the server may hand out
+ * @param[in] name URL path without the leading slash
+ * @param[out] file
+ * @return qfalse if the file isn't served
+ */
+static qboolean SV_HTTP_FindFile(const char *name, httpFile_t *file)
+{
+	int i;
+
+	SV_HTTP_Lock();
+	for (i = 0; i < http_numFiles; i++)
+	{
+		if (!Q_stricmp(http_files[i].name, name))
+		{
+			*file = http_files[i];
+			SV_HTTP_Unlock();
+			return qtrue;
+		}
+	}
+	SV_HTTP_Unlock();
+
+	return qfalse;
+}
+
+/**
+ * @brief SV_HTTP_CloseConnection
+ * @param[in,out] conn
+ */
+static void SV_HTTP_CloseConnection(httpConnection_t *conn)
+{
+	if (conn->file)
+	{
+		fclose(conn->file);
+	}
+	closesocket(conn->sock);
+
+	Com_Memset(conn, 0, sizeof(*conn));
+	conn->sock = INVALID_SOCKET;
+}
+
+/**
+ * @brief Queues the response header, the body follows from the file if any
+ * @param[in,out] conn
+ * @param[in] status
+ * @param[in] headers extra header lines
+ * @param[in] contentLength
+ */
+static void SV_HTTP_Respond(httpConnection_t *conn, const char *status, const char *headers, long contentLength)
+{
+	Com_sprintf(conn->buffer, sizeof(conn->buffer),
+	            "HTTP/1.1 %s\r\n"
+	            "Server: " PRODUCT_LABEL "\r\n"
+	            "Content-Length: %ld\r\n"
+	            "Accept-Ranges: bytes\r\n"
+	            "Connection: close\r\n"
+	            "%s\r\n",
+	            status, contentLength, headers);
+
+	conn->length     = strlen(conn->buffer);
+	conn->sent       = 0;
+	conn->responding = qtrue;
+}
+
+/**
+ * @brief Decodes %XX escapes of a URL path in place
+ * @param[in,out] path
+ */
+static void SV_HTTP_DecodePath(char *path)
+{
+	char *out = path;
+	int  c;
+
+	for ( ; *path; path++)
+	{
+		if (*path == '%' && sscanf(path + 1, "%2x", &c) == 1 && c)
+		{
+			*out++ = (char)c;
+			path  += 2;
+		}
+		else
+		{
+			*out++ = *path;
+		}
+	}
+	*out = '\0';
+}
+
+/**
+ * @brief Parses a decimal number of a Range header
+ * @param[in,out] s advanced past the digits
+ * @param[out] value
+ * @return qfalse if there are no digits or the number doesn't fit a long
+ */
+static qboolean SV_HTTP_ParseNumber(const char **s, long *value)
+{
+	const char *p = *s;
+
+	*value = 0;
+	while (*p >= '0' && *p <= '9')
+	{
+		if (*value > (LONG_MAX - (*p - '0')) / 10)
+		{
+			return qfalse;
+		}
+		*value = *value * 10 + (*p - '0');
+		p++;
+	}
+
+	if (p == *s)
+	{
+		return qfalse;
+	}
+
+	*s = p;
+	return qtrue;
+}
+
+/**
+ * @brief Parses the value of a single range Range header
+ *
+ * Accepts "bytes=start-", "bytes=start-last" and the suffix form "bytes=-length".
+ * Anything else, multiple ranges included, is ignored and answered with the
+ * whole file as the RFC allows.
+ *
+ * @param[in] range header value
+ * @param[in] size of the file
+ * @param[out] start first byte to send
+ * @param[out] end byte after the last one to send, clamped to the file
+ * @return qfalse if the header has to be ignored
+ */
+static qboolean SV_HTTP_ParseRange(const char *range, long size, long *start, long *end)
+{
+	long first, last;
+
+	while (*range == ' ')
+	{
+		range++;
+	}
+
+	if (Q_stricmpn(range, "bytes=", 6))
+	{
+		return qfalse;
+	}
+	range += 6;
+
+	if (*range == '-')
+	{
+		range++;
+		if (!SV_HTTP_ParseNumber(&range, &last))
+		{
+			return qfalse;
+		}
+
+		// a zero length suffix is unsatisfiable
+		first = last ? MAX(size - last, 0) : size;
+		last  = size;
+	}
+	else
+	{
+		if (!SV_HTTP_ParseNumber(&range, &first) || *range++ != '-')
+		{
+			return qfalse;
+		}
+
+		if (*range >= '0' && *range <= '9')
+		{
+			if (!SV_HTTP_ParseNumber(&range, &last) || last < first)
+			{
+				return qfalse;
+			}
+			last = (last >= size) ? size : last + 1;
+		}
+		else
+		{
+			last = size;
+		}
+	}
+
+	while (*range == ' ')
+	{
+		range++;
+	}
+
+	if (*range != '\r')
+	{
+		return qfalse;
+	}
+
+	*start = first;
+	*end   = last;
+	return qtrue;
+}
+
+/**
+ * @brief Answers a complete request
+ * @param[in,out] conn
+ */
+static void SV_HTTP_HandleRequest(httpConnection_t *conn)
+{
+	char       method[8], path[MAX_QPATH + 1], *query;
+	char       headers[128] = "", type[160];
+	const char *range;
+	httpFile_t file;
+	long       start, end;
+	qboolean   head, partial = qfalse;
+
+	// %64s is MAX_QPATH
+	if (sscanf(conn->buffer, "%7s /%64s HTTP/", method, path) != 2)
+	{
+		SV_HTTP_Respond(conn, "400 Bad Request", "", 0);
+		return;
+	}
+
+	head = !Q_stricmp(method, "HEAD");
+	if (!head && Q_stricmp(method, "GET"))
+	{
+		SV_HTTP_Respond(conn, "405 Method Not Allowed", "Allow: GET, HEAD\r\n", 0);
+		return;
+	}
+
+	query = strchr(path, '?');
+	if (query)
+	{
+		*query = '\0';
+	}
+	SV_HTTP_DecodePath(path);
+
+	// only the table is served, so there is no path to escape from
+	if (!SV_HTTP_FindFile(path, &file))
+	{
+		SV_HTTP_Respond(conn, "404 Not Found", "", 0);
+		return;
+	}
+
+	start = 0;
+	end   = file.size;
+
+	range = Q_stristr(conn->buffer, "\r\nRange:");
+	if (range && SV_HTTP_ParseRange(range + 8, file.size, &start, &end))
+	{
+		if (start >= end)
+		{
+			Com_sprintf(headers, sizeof(headers), "Content-Range: bytes */%ld\r\n", file.size);
+			SV_HTTP_Respond(conn, "416 Range Not Satisfiable", headers, 0);
+			return;
+		}
+
+		Com_sprintf(headers, sizeof(headers), "Content-Range: bytes %ld-%ld/%ld\r\n", start, end - 1, file.size);
+		partial = qtrue;
+	}
+
+	if (!head)
+	{
+		conn->file = Sys_FOpen(file.path, "rb");
+		if (!conn->file)
+		{
+			SV_HTTP_Respond(conn, "404 Not Found", "", 0);
+			return;
+		}
+	}
+
+	// no va(), it isn't thread safe
+	Com_sprintf(type, sizeof(type), "Content-Type: application/octet-stream\r\n%s", headers);
+	SV_HTTP_Respond(conn, partial ? "206 Partial Content" : "200 OK", type, end - start);
+
+	conn->offset = start;
+	conn->end    = head ? start : end;
+}
+
+/**
+ * @brief Reads the request of a connection
+ * @param[in,out] conn
+ * @return qfalse if the connection has to be closed
+ */
+static qboolean SV_HTTP_ReadRequest(httpConnection_t *conn)
+{
+	int ret;
+
+	ret = recv(conn->sock, conn->buffer + conn->length, sizeof(conn->buffer) - 1 - conn->length, 0);
+	if (ret <= 0)
+	{
+		return ret < 0 && socketError == SOCKET_WOULDBLOCK;
+	}
+
+	conn->length                += ret;
+	conn->buffer[conn->length]   = '\0';
+
+	if (strstr(conn->buffer, "\r\n\r\n"))
+	{
+		SV_HTTP_HandleRequest(conn);
+	}
+	else if (conn->length == sizeof(conn->buffer) - 1)
+	{
+		SV_HTTP_Respond(conn, "431 Request Header Fields Too Large", "", 0);
+	}
+
+	return qtrue;
+}
+
+/**
+ * @brief Refills the rate bucket of a connection
+ * @param[in,out] conn
+ * @return qfalse if the connection has to wait for the rate
+ */
+static qboolean SV_HTTP_Refill(httpConnection_t *conn)
+{
+	int64_t now = Sys_Microseconds();
+
+	if (!http_rate)
+	{
+		return qtrue;
+	}
+
+	// allow a burst of a tenth of a second
+	conn->credit += (now - conn->lastTime) * http_rate;
+	if (conn->credit > (int64_t)http_rate * 100000)
+	{
+		conn->credit = (int64_t)http_rate * 100000;
+	}
+	conn->lastTime = now;
+
+	// wait for a select interval worth of data so the thread doesn't spin
+	// on sends of a few bytes
+	return conn->credit >= MIN((int64_t)(conn->end - conn->offset) * 1000000, (int64_t)http_rate * HTTP_SELECT_USEC);
+}
+
+/**
+ * @brief Sends what the rate allows of the response of a connection
+ * @param[in,out] conn
+ * @return qfalse once the connection has to be closed
+ */
+static qboolean SV_HTTP_WriteResponse(httpConnection_t *conn)
+{
+	long count;
+	int  ret;
+
+	if (conn->sent < conn->length)
+	{
+		ret = send(conn->sock, conn->buffer + conn->sent, conn->length - conn->sent, MSG_NOSIGNAL);
+		if (ret < 0)
+		{
+			return socketError == SOCKET_WOULDBLOCK;
+		}
+		conn->sent += ret;
+		return qtrue;
+	}
+
+	if (conn->offset >= conn->end)
+	{
+		return qfalse;  // done
+	}
+
+	count = MIN(conn->end - conn->offset, HTTP_CHUNK_SIZE);
+
+	if (http_rate && count > conn->credit / 1000000)
+	{
+		count = (long)(conn->credit / 1000000);
+	}
+
+#ifdef __linux__
+	{
+		off_t offset = conn->offset;
+
+		// zero copy from the page cache
+		ret = sendfile(conn->sock, fileno(conn->file), &offset, count);
+	}
+#else
+	{
+		static byte buffer[HTTP_CHUNK_SIZE];   // only used by the thread
+
+		if (fseek(conn->file, conn->offset, SEEK_SET) || (count = fread(buffer, 1, count, conn->file)) <= 0)
+		{
+			return qfalse;
+		}
+		ret = send(conn->sock, (const char *)buffer, count, MSG_NOSIGNAL);
+	}
+#endif
+
+	if (ret <= 0)
+	{
+		return ret < 0 && socketError == SOCKET_WOULDBLOCK;
+	}
+
+	conn->offset += ret;
+	conn->credit -= (int64_t)ret * 1000000;
+
+	return qtrue;
+}
+
+/**
+ * @brief Stores the address of a client as an IPv4 mapped IPv6 address
+ * @param[in] from
+ * @param[out] address
+ */
+static void SV_HTTP_Address(const struct sockaddr *from, byte *address)
+{
+	Com_Memset(address, 0, 16);
+
+	if (from->sa_family == AF_INET)
+	{
+		address[10] = 0xff;
+		address[11] = 0xff;
+		Com_Memcpy(address + 12, &((const struct sockaddr_in *)from)->sin_addr, 4);
+	}
+#ifdef FEATURE_IPV6
+	else if (from->sa_family == AF_INET6)
+	{
+		Com_Memcpy(address, &((const struct sockaddr_in6 *)from)->sin6_addr, 16);
+	}
+#endif
+}
+
+/**
+ * @brief Accepts a new connection
+ * @param[in] listener
+ */
+static void SV_HTTP_Accept(SOCKET listener)
+{
+	httpConnection_t        *conn = NULL;
+	struct sockaddr_storage from;
+	socklen_t               fromLength = sizeof(from);
+	byte                    address[16];
+	SOCKET                  sock;
+	u_long                  _true = 1;
+	int                     i, count = 0;
+
+	sock = accept(listener, (struct sockaddr *)&from, &fromLength);
+	if (sock == INVALID_SOCKET)
+	{
+		return;
+	}
+
+	SV_HTTP_Address((struct sockaddr *)&from, address);
+
+	for (i = 0; i < HTTP_MAX_CONNECTIONS; i++)
+	{
+		if (http_connections[i].sock == INVALID_SOCKET)
+		{
+			if (!conn)
+			{
+				conn = &http_connections[i];
+			}
+		}
+		else if (!memcmp(http_connections[i].address, address, sizeof(address)))
+		{
+			count++;
+		}
+	}
+
+	// one client can't take all the slots
+	if (!conn || count >= HTTP_MAX_PER_ADDRESS || ioctlsocket(sock, FIONBIO, &_true) == SOCKET_ERROR)
+	{
+		closesocket(sock);
+		return;
+	}
+
+#ifdef SO_NOSIGPIPE
+	setsockopt(sock, SOL_SOCKET, SO_NOSIGPIPE, (const char *)&_true, sizeof(int));
+#endif
+
+	conn->sock         = sock;
+	conn->lastActivity = Sys_Milliseconds();
+	conn->acceptTime   = conn->lastActivity;
+	conn->lastTime     = Sys_Microseconds();
+	conn->credit       = 0;
+	Com_Memcpy(conn->address, address, sizeof(conn->address));
+}
+
+/**
+ * @brief Serves the connections until SV_HTTP_Shutdown
+ */
+static void SV_HTTP_Thread(void)
+{
+	fd_set           readSet, writeSet;
+	struct timeval   timeout;
+	httpConnection_t *conn;
+	SOCKET           highest;
+	int              i, now, sent;
+	long             offset;
+
+	while (!http_quit)
+	{
+		now = Sys_Milliseconds();
+
+		FD_ZERO(&readSet);
+		FD_ZERO(&writeSet);
+		FD_SET(http_socket, &readSet);
+		highest = http_socket;
+		if (http_socket6 != INVALID_SOCKET)
+		{
+			FD_SET(http_socket6, &readSet);
+			if (http_socket6 > highest)
+			{
+				highest = http_socket6;
+			}
+		}
+
+		for (i = 0, conn = http_connections; i < HTTP_MAX_CONNECTIONS; i++, conn++)
+		{
+			if (conn->sock == INVALID_SOCKET)
+			{
+				continue;
+			}
+
+			if (conn->responding)
+			{
+				// the select timeout wakes up connections waiting for the rate,
+				// only the client itself counts against HTTP_TIMEOUT
+				if (conn->sent < conn->length || SV_HTTP_Refill(conn))
+				{
+					FD_SET(conn->sock, &writeSet);
+				}
+				else
+				{
+					conn->lastActivity = now;
+				}
+			}
+			else
+			{
+				FD_SET(conn->sock, &readSet);
+			}
+
+			if (conn->sock > highest)
+			{
+				highest = conn->sock;
+			}
+		}
+
+		timeout.tv_sec  = 0;
+		timeout.tv_usec = HTTP_SELECT_USEC;
+
+		if (select(highest + 1, &readSet, &writeSet, NULL, &timeout) < 0)
+		{
+			continue;
+		}
+
+		if (FD_ISSET(http_socket, &readSet))
+		{
+			SV_HTTP_Accept(http_socket);
+		}
+		if (http_socket6 != INVALID_SOCKET && FD_ISSET(http_socket6, &readSet))
+		{
+			SV_HTTP_Accept(http_socket6);
+		}
+
+		now = Sys_Milliseconds();
+
+		for (i = 0, conn = http_connections; i < HTTP_MAX_CONNECTIONS; i++, conn++)
+		{
+			if (conn->sock == INVALID_SOCKET)
+			{
+				continue;
+			}
+
+			sent   = conn->sent;
+			offset = conn->offset;
+
+			if (FD_ISSET(conn->sock, &readSet))
+			{
+				if (!SV_HTTP_ReadRequest(conn))
+				{
+					SV_HTTP_CloseConnection(conn);
+					continue;
+				}
+				conn->lastActivity = now;
+			}
+			else if (FD_ISSET(conn->sock, &writeSet))
+			{
+				if (!SV_HTTP_WriteResponse(conn))
+				{
+					SV_HTTP_CloseConnection(conn);
+					continue;
+				}
+				if (conn->sent != sent || conn->offset != offset)
+				{
+					conn->lastActivity = now;
+				}
+			}
+
+			// a client trickling the headers keeps lastActivity fresh
+			if (now - conn->lastActivity > HTTP_TIMEOUT
+			    || (!conn->responding && now - conn->acceptTime > HTTP_REQUEST_TIMEOUT))
+			{
+				SV_HTTP_CloseConnection(conn);
+			}
+		}
+	}
+
+	for (i = 0; i < HTTP_MAX_CONNECTIONS; i++)
+	{
+		if (http_connections[i].sock != INVALID_SOCKET)
+		{
+			SV_HTTP_CloseConnection(&http_connections[i]);
+		}
+	}
+}
+
+/**
+ * @brief Resolves a package name to the file the netchan download would send
+ * @param[in] name
+ * @param[out] path
+ * @param[in] size
+ * @return the file size, -1 if not found
+ */
+static long SV_HTTP_FindPath(const char *name, char *path, size_t size)
+{
+	const char *bases[2];
+	char       *ospath;
+	FILE       *f;
+	long       length;
+	int        i;
+
+	bases[0] = Cvar_VariableString("fs_homepath");
+	bases[1] = Cvar_VariableString("fs_basepath");
+
+	for (i = 0; i < 2; i++)
+	{
+		ospath                     = FS_BuildOSPath(bases[i], name, "");
+		ospath[strlen(ospath) - 1] = '\0';   // remove trailing slash
+
+		f = Sys_FOpen(ospath, "rb");
+		if (!f)
+		{
+			continue;
+		}
+
+		fseek(f, 0, SEEK_END);
+		length = ftell(f);
+		fclose(f);
+
+		Q_strncpyz(path, ospath, size);
+		return length;
+	}
+
+	return -1;
+}
+
+/**
+ * @brief Opens a listening socket
+ * @param[in] family AF_INET or AF_INET6
+ * @param[in] port
+ * @return INVALID_SOCKET on failure
+ */
+static SOCKET SV_HTTP_Listen(int family, int port)
+{
+	struct sockaddr_storage address;
+	socklen_t               length;
+	SOCKET                  sock;
+	u_long                  _true = 1;
+
+	sock = socket(family, SOCK_STREAM, IPPROTO_TCP);
+	if (sock == INVALID_SOCKET)
+	{
+		return INVALID_SOCKET;
+	}
+
+	setsockopt(sock, SOL_SOCKET, SO_REUSEADDR, (const char *)&_true, sizeof(int));
+
+	Com_Memset(&address, 0, sizeof(address));
+#ifdef FEATURE_IPV6
+	if (family == AF_INET6)
+	{
+		// the IPv4 socket takes the IPv4 clients
+		setsockopt(sock, IPPROTO_IPV6, IPV6_V6ONLY, (const char *)&_true, sizeof(int));
+
+		((struct sockaddr_in6 *)&address)->sin6_family = AF_INET6;
+		((struct sockaddr_in6 *)&address)->sin6_addr   = in6addr_any;
+		((struct sockaddr_in6 *)&address)->sin6_port   = htons((unsigned short)port);
+		length                                         = sizeof(struct sockaddr_in6);
+	}
+	else
+#endif
+	{
+		((struct sockaddr_in *)&address)->sin_family      = AF_INET;
+		((struct sockaddr_in *)&address)->sin_addr.s_addr = INADDR_ANY;
+		((struct sockaddr_in *)&address)->sin_port        = htons((unsigned short)port);
+		length                                            = sizeof(struct sockaddr_in);
+	}
+
+	if (bind(sock, (struct sockaddr *)&address, length) == SOCKET_ERROR
+	    || listen(sock, 16) == SOCKET_ERROR
+	    || ioctlsocket(sock, FIONBIO, &_true) == SOCKET_ERROR)
+	{
+		closesocket(sock);
+		return INVALID_SOCKET;
+	}
+
+	return sock;
+}
+
+/**
+ * @brief Closes the listening sockets
+ */
+static void SV_HTTP_CloseListeners(void)
+{
+	closesocket(http_socket);
+	http_socket = INVALID_SOCKET;
+
+	if (http_socket6 != INVALID_SOCKET)
+	{
+		closesocket(http_socket6);
+		http_socket6 = INVALID_SOCKET;
+	}
+}
+
+/**
+ * @brief Opens the listening sockets and starts the thread
+ * @param[in] port
+ * @return qfalse on failure
+ */
+static qboolean SV_HTTP_Start(int port)
+{
+	int i;
+
+	http_socket = SV_HTTP_Listen(AF_INET, port);
+	if (http_socket == INVALID_SOCKET)
+	{
+		Com_Printf(S_COLOR_YELLOW "WARNING: SV_HTTP_Start: can't listen on TCP port %i\n", port);
+		return qfalse;
+	}
+
+#ifdef FEATURE_IPV6
+	http_socket6 = SV_HTTP_Listen(AF_INET6, port);
+	if (http_socket6 == INVALID_SOCKET)
+	{
+		Com_Printf(S_COLOR_YELLOW "WARNING: SV_HTTP_Start: can't listen on IPv6 TCP port %i, serving IPv4 only\n", port);
+	}
+#endif
+
+	for (i = 0; i < HTTP_MAX_CONNECTIONS; i++)
+	{
+		Com_Memset(&http_connections[i], 0, sizeof(http_connections[i]));
+		http_connections[i].sock = INVALID_SOCKET;
+	}
+
+	http_quit = qfalse;
+	if (!SV_HTTP_StartThread())
+	{
+		Com_Printf(S_COLOR_YELLOW "WARNING: SV_HTTP_Start: can't create thread\n");
+		SV_HTTP_CloseListeners();
+		return qfalse;
+	}
+
+	http_running = qtrue;
+	http_port    = port;
+
+	Com_Printf("HTTP download server listening on TCP port %i\n", port);
+	if (!*sv_wwwBaseURL->string || !sv_wwwDownload->integer)
+	{
+		Com_Printf(S_COLOR_YELLOW "WARNING: set sv_wwwDownload 1 and sv_wwwBaseURL http://<address>:%i to redirect clients\n", port);
+	}
+
+	return qtrue;
+}
+
+/**
+ * @brief Stops the HTTP download server
+ */
+void SV_HTTP_Shutdown(void)
+{
+	if (!http_running)
+	{
+		return;
+	}
+
+	http_quit = qtrue;
+	SV_HTTP_WaitThread();
+
+	SV_HTTP_CloseListeners();
+	http_running = qfalse;
+	http_port    = 0;
+}
+
+/**
+ * @brief (Re)starts the HTTP download server as sv_httpPort asks and hands it
+ * the packages of the current map
+ *
+ * @note Called after every map load, once sv_referencedPakNames is set
+ */
+void SV_HTTP_Update(void)
+{
+	httpFile_t files[HTTP_MAX_FILES];
+	int        numFiles = 0;
+	char       *p, *token;
+
+	if (http_running && http_port != sv_httpPort->integer)
+	{
+		SV_HTTP_Shutdown();
+	}
+
+	if (sv_httpPort->integer <= 0)
+	{
+		return;
+	}
+
+	http_rate = sv_httpRate->integer > 0 ? sv_httpRate->integer * 1024 : 0;
+
+	p = Cvar_VariableString("sv_referencedPakNames");
+	while (sv_allowDownload->integer && numFiles < HTTP_MAX_FILES)
+	{
+		token = COM_Parse(&p);
+		if (!*token)
+		{
+			break;
+		}
+
+		// same restriction as SV_CheckDownloadAllowed
+		if (FS_idPak(token, BASEGAME))
+		{
+			continue;
+		}
+
+		Com_sprintf(files[numFiles].name, sizeof(files[numFiles].name), "%s.pk3", token);
+		files[numFiles].size = SV_HTTP_FindPath(files[numFiles].name, files[numFiles].path, sizeof(files[numFiles].path));
+		if (files[numFiles].size > 0)
+		{
+			numFiles++;
+		}
+	}
+
+	if (!http_running && !SV_HTTP_Start(sv_httpPort->integer))
+	{
+		return;
+	}
+
+	SV_HTTP_Lock();
+	Com_Memcpy(http_files, files, numFiles * sizeof(files[0]));
+	http_numFiles = numFiles;
+	SV_HTTP_Unlock();
+}
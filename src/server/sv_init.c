@@ -38,6 +38,22 @@
 // we even log attacks when the server is waiting for rcon and doesn't run a map
 int attHandle = 0; // server attack log file handle
 
+/**
+ * @brief Replaces a configstring and keeps its length
+ * @param[in] index
+ * @param[in] val
+ */
+static void SV_StoreConfigstring(int index, const char *val)
+{
+	int len = strlen(val);
+
+	Z_Free(sv.configstrings[index]);
+	sv.configstrings[index] = CopyString(val);
+
+	sv.configstringsTotal         += len - sv.configstringsLength[index];
+	sv.configstringsLength[index] = len;
+}
+
 /**
  * @brief SV_SetConfigstringNoUpdate
  * @param[in] index
@@ -62,8 +78,7 @@ void SV_SetConfigstringNoUpdate(int index, const char *val)
 	}
 
 	// change the string in sv
-	Z_Free(sv.configstrings[index]);
-	sv.configstrings[index] = CopyString(val);
+	SV_StoreConfigstring(index, val);
 }
 
 /**
@@ -90,9 +105,14 @@ void SV_SetConfigstring(int index, const char *val)
 	}
 
 	// change the string in sv
-	Z_Free(sv.configstrings[index]);
-	sv.configstrings[index]         = CopyString(val);
-	sv.configstringsmodified[index] = qtrue;
+	SV_StoreConfigstring(index, val);
+
+	// queue it once, no matter how often it changes until the next update
+	if (!sv.configstringsmodified[index])
+	{
+		sv.configstringsmodified[index]                   = qtrue;
+		sv.configstringsDirty[sv.numConfigstringsDirty++] = index;
+	}
 
 	// save config strings to demo
 	if (sv.demoState == DS_RECORDING)
@@ -103,113 +123,125 @@ void SV_SetConfigstring(int index, const char *val)
 
 #define NEXT_WARNING_TIME 5000
 
+/**
+ * @brief Sends a configstring update command to all clients that get the configstring
+ * @param[in] index
+ * @param[in] cmd formatted once and shared by all clients
+ */
+static void SV_SendConfigstringCommand(int index, const char *cmd)
+{
+	client_t          *client;
+	reliableCommand_t *command = SV_AllocServerCommand(cmd);
+	int               i;
+
+	for (i = 0, client = svs.clients; i < sv_maxclients->integer ; i++, client++)
+	{
+		if (client->state < CS_PRIMED || client->demoClient)
+		{
+			continue;
+		}
+		// do not always send server info to all clients
+		if (index == CS_SERVERINFO && client->gentity && (client->gentity->r.svFlags & SVF_NOSERVERINFO))
+		{
+			continue;
+		}
+
+		SV_AddSharedServerCommand(client, command);
+	}
+
+	SV_ReleaseServerCommand(command);
+}
+
 /**
  * @brief Updates the configstring
  * @note It's nice to know this function sends several server commands when a configstring is greater than 1000 usually BIG_INFO_STRINGs
  */
 void SV_UpdateConfigStrings(void)
 {
-	client_t   *client;
-	int        len, i, index, sent, remaining, cstotal = 0;
+	int        len, i, index, sent, remaining;
 	int        maxChunkSize = MAX_STRING_CHARS - 24;
 	const char *cmd;
 	char       buf[MAX_STRING_CHARS];
 	static int nextWarningSysInfoTime   = 0;
 	static int nextWarningGameStateTime = 0;
 
-	for (index = 0; index < MAX_CONFIGSTRINGS; index++)
+	if (sv.configstringsLength[CS_SYSTEMINFO] && nextWarningSysInfoTime <= svs.time)
 	{
-		if (sv.configstrings[index][0])
+		nextWarningSysInfoTime = svs.time + NEXT_WARNING_TIME;
+
+		// about 10% of BIG_INFO_VALUE - this grants the server will start properly
+		// but total CS limit might be reached soon when CS_SYSTEMINFO uses nearly half of total CS
+		// warn admins
+		if (sv.configstringsLength[CS_SYSTEMINFO] > BIG_INFO_VALUE - 800)
 		{
-			// get total CS length
-			cstotal += strlen(sv.configstrings[index]);
+			Com_Printf(S_COLOR_YELLOW "WARNING: Your server nearly reached a configstring limit [%i chars left] - reduce the ammount of maps/pk3s in path\n", BIG_INFO_VALUE - sv.configstringsLength[CS_SYSTEMINFO]);
+		}
+	}
 
-			if (index == CS_SYSTEMINFO)
-			{
-				if (nextWarningSysInfoTime <= svs.time)
-				{
-					nextWarningSysInfoTime = svs.time + NEXT_WARNING_TIME;
+	if (!sv.numConfigstringsDirty)
+	{
+		return;
+	}
 
-					// about 10% of BIG_INFO_VALUE - this grants the server will start properly
-					// but total CS limit might be reached soon when CS_SYSTEMINFO uses nearly half of total CS
-					// warn admins
-					if (strlen(sv.configstrings[index]) > BIG_INFO_VALUE - 800)
-					{
-						Com_Printf(S_COLOR_YELLOW "WARNING: Your server nearly reached a configstring limit [%i chars left] - reduce the ammount of maps/pk3s in path\n", (int) (BIG_INFO_VALUE - strlen(sv.configstrings[index])));
-					}
-				}
-			}
-		}
+	for (i = 0; i < sv.numConfigstringsDirty; i++)
+	{
+		index = sv.configstringsDirty[i];
 
-		if (!sv.configstringsmodified[index])
-		{
-			continue;
-		}
 		sv.configstringsmodified[index] = qfalse;
 
 		// send it to all the clients if we aren't
 		// spawning a new server
-		if (sv.state == SS_GAME || sv.restarting)
+		if (sv.state != SS_GAME && !sv.restarting)
 		{
-			// send the data to all relevent clients
-			for (i = 0, client = svs.clients; i < sv_maxclients->integer ; i++, client++)
+			continue;
+		}
+
+		len = sv.configstringsLength[index];
+		if (len >= maxChunkSize)
+		{
+			sent      = 0;
+			remaining = len;
+
+			while (remaining > 0)
 			{
-				if (client->state < CS_PRIMED)
+				if (sent == 0)
 				{
-					continue;
+					cmd = "bcs0";
 				}
-				// do not always send server info to all clients
-				if (index == CS_SERVERINFO && client->gentity && (client->gentity->r.svFlags & SVF_NOSERVERINFO))
+				else if (remaining < maxChunkSize)
 				{
-					continue;
-				}
-
-				len = strlen(sv.configstrings[index]);
-				if (len >= maxChunkSize)
-				{
-					sent      = 0;
-					remaining = len;
-
-					while (remaining > 0)
-					{
-						if (sent == 0)
-						{
-							cmd = "bcs0";
-						}
-						else if (remaining < maxChunkSize)
-						{
-							cmd = "bcs2";
-						}
-						else
-						{
-							cmd = "bcs1";
-						}
-
-						Q_strncpyz(buf, &sv.configstrings[index][sent], maxChunkSize);
-
-						SV_SendServerCommand(client, "%s %i \"%s\"\n", cmd, index, buf);
-
-						sent      += (maxChunkSize - 1);
-						remaining -= (maxChunkSize - 1);
-					}
+					cmd = "bcs2";
 				}
 				else
 				{
-					// standard cs, just send it
-					SV_SendServerCommand(client, "cs %i \"%s\"\n", index, sv.configstrings[index]);
+					cmd = "bcs1";
 				}
+
+				Q_strncpyz(buf, &sv.configstrings[index][sent], maxChunkSize);
+
+				SV_SendConfigstringCommand(index, va("%s %i \"%s\"\n", cmd, index, buf));
+
+				sent      += (maxChunkSize - 1);
+				remaining -= (maxChunkSize - 1);
 			}
 		}
-
-		if (nextWarningGameStateTime <= svs.time)
+		else
 		{
-			nextWarningGameStateTime = svs.time + NEXT_WARNING_TIME;
+			// standard cs, just send it
+			SV_SendConfigstringCommand(index, va("cs %i \"%s\"\n", index, sv.configstrings[index]));
+		}
+	}
 
-			// warn admins
-			if (cstotal > MAX_GAMESTATE_CHARS - 800) // 5% of MAX_GAMESTATE_CHARS
-			{
-				Com_Printf(S_COLOR_YELLOW "WARNING: Your clients might be disconnected by configstring limit [%i chars left] - reduce the ammount of maps/pk3s in path\n", MAX_GAMESTATE_CHARS - cstotal);
-			}
+	sv.numConfigstringsDirty = 0;
+
+	if (nextWarningGameStateTime <= svs.time)
+	{
+		nextWarningGameStateTime = svs.time + NEXT_WARNING_TIME;
+
+		// warn admins
+		if (sv.configstringsTotal > MAX_GAMESTATE_CHARS - 800) // 5% of MAX_GAMESTATE_CHARS
+		{
+			Com_Printf(S_COLOR_YELLOW "WARNING: Your clients might be disconnected by configstring limit [%i chars left] - reduce the ammount of maps/pk3s in path\n", MAX_GAMESTATE_CHARS - sv.configstringsTotal);
 		}
 	}
 }
@@ -371,6 +403,10 @@ void SV_Startup(void)
 
 	// allocate new snapshot entities
 	SV_SetNumSnapshotEntities();
+
+	// challenges handed out by a previous run are no longer valid
+	Com_RandomBytes((byte *)svs.challengeSecret, sizeof(svs.challengeSecret));
+
 	svs.initialized = qtrue;
 
 	Cvar_Set("sv_running", "1");
@@ -422,6 +458,16 @@ void SV_ChangeMaxClients(void)
 		}
 	}
 
+	// the clients that aren't kept release their server commands and queue buffers
+	for (i = 0 ; i < oldMaxClients ; i++)
+	{
+		if (svs.clients[i].state < CS_CONNECTED)
+		{
+			SV_FreeServerCommands(&svs.clients[i]);
+			SV_Netchan_ClearQueue(&svs.clients[i]);
+		}
+	}
+
 	// free old clients arrays
 	//Z_Free( svs.clients );
 	Com_Dealloc(svs.clients);      // avoid trying to allocate large chunk on a fragmented zone
@@ -583,6 +629,16 @@ void SV_DemoChangeMaxClients(void)
 		Com_Memset(&oldClients[i], 0, sizeof(client_t));
 	}
 
+	// the clients that aren't kept release their server commands and queue buffers
+	for (i = 0 ; i < oldMaxClients ; i++)
+	{
+		if (svs.clients[i].state < CS_CONNECTED)
+		{
+			SV_FreeServerCommands(&svs.clients[i]);
+			SV_Netchan_ClearQueue(&svs.clients[i]);
+		}
+	}
+
 	// free old clients arrays
 	Z_Free(svs.clients);
 
@@ -910,6 +966,9 @@ void SV_SpawnServer(const char *server)
 	}
 	Cvar_Set("sv_referencedPakNames", p);
 
+	// hand the packages to the HTTP download server
+	SV_HTTP_Update();
+
 	// save systeminfo and serverinfo strings
 	cvar_modifiedFlags &= ~CVAR_SYSTEMINFO;
 	SV_SetConfigstring(CS_SYSTEMINFO, Cvar_InfoString_Big(CVAR_SYSTEMINFO));
@@ -1123,7 +1182,9 @@ void SV_Init(void)
 	sv_killserver  = Cvar_Get("sv_killserver", "0", 0);
 	sv_mapChecksum = Cvar_Get("sv_mapChecksum", "", CVAR_ROM);
 
-	sv_lanForceRate = Cvar_Get("sv_lanForceRate", "1", CVAR_ARCHIVE_ND);
+	sv_lanForceRate      = Cvar_Get("sv_lanForceRate", "1", CVAR_ARCHIVE_ND);
+	sv_adaptiveSnapshots = Cvar_Get("sv_adaptiveSnapshots", "0", CVAR_ARCHIVE_ND);
+	sv_snapshotPriority  = Cvar_Get("sv_snapshotPriority", "0", CVAR_ARCHIVE_ND);
 
 	sv_onlyVisibleClients = Cvar_Get("sv_onlyVisibleClients", "0", 0);
 
@@ -1153,6 +1214,8 @@ void SV_Init(void)
 	sv_wwwDownload       = Cvar_Get("sv_wwwDownload", "0", CVAR_ARCHIVE);
 	sv_wwwBaseURL        = Cvar_Get("sv_wwwBaseURL", "", CVAR_ARCHIVE);
 	sv_wwwDlDisconnected = Cvar_Get("sv_wwwDlDisconnected", "0", CVAR_ARCHIVE);
+	sv_httpPort          = Cvar_Get("sv_httpPort", "0", CVAR_ARCHIVE);    // applied on map load
+	sv_httpRate          = Cvar_Get("sv_httpRate", "0", CVAR_ARCHIVE);
 	sv_wwwFallbackURL    = Cvar_Get("sv_wwwFallbackURL", "", CVAR_ARCHIVE);
 
 	sv_packetloss  = Cvar_Get("sv_packetloss", "0", CVAR_CHEAT);
@@ -1245,6 +1308,8 @@ void SV_Shutdown(const char *finalmsg)
 	// close attack log
 	SV_CloseAttackLog();
 
+	SV_HTTP_Shutdown();
+
 	if (!com_sv_running || !com_sv_running->integer)
 	{
 		return;
@@ -1282,11 +1347,13 @@ void SV_Shutdown(const char *finalmsg)
 		for (index = 0; index < sv_maxclients->integer; index++)
 		{
 			SV_Netchan_ClearQueue(&svs.clients[index]);
+			SV_FreeServerCommands(&svs.clients[index]);
 		}
 
 		//Z_Free( svs.clients );
 		Com_Dealloc(svs.clients);      // avoid trying to allocate large chunk on a fragmented zone
 	}
+	SV_Netchan_FreePool();
 	Com_Memset(&svs, 0, sizeof(svs));
 	svs.serverLoad = -1;
 
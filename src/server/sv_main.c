@@ -67,6 +67,8 @@ cvar_t *sv_pure;
 cvar_t *sv_floodProtect;
 cvar_t *sv_userInfoFloodProtect;
 cvar_t *sv_lanForceRate;        // dedicated 1 (LAN) server forces local client rates to 99999 (bug #491)
+cvar_t *sv_adaptiveSnapshots;   // lower the snapshot rate of clients that choke or lose packets
+cvar_t *sv_snapshotPriority;    // fit snapshot entities into the client's rate by priority
 cvar_t *sv_onlyVisibleClients;
 cvar_t *sv_friendlyFire;
 cvar_t *sv_maxlives;
@@ -81,6 +83,8 @@ cvar_t *sv_wwwBaseURL;          // base URL for redirect
 // tell clients to perform their downloads while disconnected from the server
 // this gets you a better throughput, but you loose the ability to control the download usage
 cvar_t *sv_wwwDlDisconnected;
+cvar_t *sv_httpPort;            // TCP port of the built-in HTTP download server, 0 is off
+cvar_t *sv_httpRate;            // KB/s per HTTP download, 0 is unlimited
 cvar_t *sv_wwwFallbackURL; // URL to send to if an http/ftp fails or is refused client side
 
 cvar_t *sv_cheats;
@@ -165,14 +169,81 @@ static char *SV_ExpandNewlines(char *in)
 	return string;
 }
 
+/**
+ * @brief Copies a server command into a shared command
+ * @param[in] cmd
+ * @return command referenced by the caller until it releases it
+ */
+reliableCommand_t *SV_AllocServerCommand(const char *cmd)
+{
+	int               length = strlen(cmd);
+	reliableCommand_t *command;
+
+	if (length > MAX_STRING_CHARS - 1)
+	{
+		length = MAX_STRING_CHARS - 1;
+	}
+
+	command = (reliableCommand_t *)Z_Malloc(sizeof(reliableCommand_t) + length);
+	Com_Memcpy(command->string, cmd, length);
+	command->string[length] = '\0';
+	command->refCount       = 1;
+
+	return command;
+}
+
+/**
+ * @brief Drops a reference to a shared command, freeing it with the last one
+ * @param[in,out] command
+ */
+void SV_ReleaseServerCommand(reliableCommand_t *command)
+{
+	if (--command->refCount <= 0)
+	{
+		Z_Free(command);
+	}
+}
+
+/**
+ * @brief Frees the command ring of a client, called before the client_t is
+ * wiped or reused
+ * @param[in,out] client
+ */
+void SV_FreeServerCommands(client_t *client)
+{
+	int i;
+
+	for (i = 0; i < MAX_RELIABLE_COMMANDS; i++)
+	{
+		if (client->reliableCommands[i])
+		{
+			SV_ReleaseServerCommand(client->reliableCommands[i]);
+			client->reliableCommands[i] = NULL;
+		}
+	}
+}
+
+/**
+ * @brief Gets a command of the ring of a client
+ * @param[in] client
+ * @param[in] sequence
+ * @return command string, empty if that slot was never filled
+ */
+const char *SV_GetServerCommand(const client_t *client, int sequence)
+{
+	const reliableCommand_t *command = client->reliableCommands[sequence & (MAX_RELIABLE_COMMANDS - 1)];
+
+	return command ? command->string : "";
+}
+
 /**
  * @brief The given command will be transmitted to the client, and is guaranteed
  * to not have future snapshot_t executed before it is executed
  *
  * @param[in,out] client
- * @param[in] cmd
+ * @param[in,out] command shared command, referenced by the ring of the client
  */
-void SV_AddServerCommand(client_t *client, const char *cmd)
+void SV_AddSharedServerCommand(client_t *client, reliableCommand_t *command)
 {
 	int index;
 
@@ -188,16 +259,39 @@ void SV_AddServerCommand(client_t *client, const char *cmd)
 		Com_Printf("===== pending server commands =====\n");
 		for (i = client->reliableAcknowledge + 1 ; i <= client->reliableSequence ; i++)
 		{
-			Com_Printf("cmd %5d: %s\n", i, client->reliableCommands[i & (MAX_RELIABLE_COMMANDS - 1)]);
+			Com_Printf("cmd %5d: %s\n", i, SV_GetServerCommand(client, i));
 		}
 
-		Com_Printf("cmd %5d: %s\n", i, cmd);
+		Com_Printf("cmd %5d: %s\n", i, command->string);
 		SV_DropClient(client, "Server command overflow");
 		return;
 	}
 
 	index = client->reliableSequence & (MAX_RELIABLE_COMMANDS - 1);
-	Q_strncpyz(client->reliableCommands[index], cmd, sizeof(client->reliableCommands[index]));
+
+	// the slot still holds the command sent MAX_RELIABLE_COMMANDS ago
+	if (client->reliableCommands[index])
+	{
+		SV_ReleaseServerCommand(client->reliableCommands[index]);
+	}
+
+	client->reliableCommands[index] = command;
+	command->refCount++;
+}
+
+/**
+ * @brief The given command will be transmitted to the client, and is guaranteed
+ * to not have future snapshot_t executed before it is executed
+ *
+ * @param[in,out] client
+ * @param[in] cmd
+ */
+void SV_AddServerCommand(client_t *client, const char *cmd)
+{
+	reliableCommand_t *command = SV_AllocServerCommand(cmd);
+
+	SV_AddSharedServerCommand(client, command);
+	SV_ReleaseServerCommand(command);
 }
 
 /**
@@ -211,10 +305,11 @@ void SV_AddServerCommand(client_t *client, const char *cmd)
  */
 void QDECL SV_SendServerCommand(client_t *cl, const char *fmt, ...)
 {
-	va_list  argptr;
-	byte     message[MAX_MSGLEN];
-	client_t *client;
-	int      j;
+	va_list           argptr;
+	byte              message[MAX_MSGLEN];
+	client_t          *client;
+	int               j;
+	reliableCommand_t *command;
 
 	va_start(argptr, fmt);
 	Q_vsnprintf((char *)message, sizeof(message), fmt, argptr);
@@ -261,7 +356,9 @@ void QDECL SV_SendServerCommand(client_t *cl, const char *fmt, ...)
 		SV_DemoWriteServerCommand((char *)message);
 	}
 
-	// send the data to all relevant clients
+	// send the data to all relevant clients, they all share a single copy
+	command = SV_AllocServerCommand((char *)message);
+
 	for (j = 0, client = svs.clients; j < sv_maxclients->integer ; j++, client++)
 	{
 		if (client->state < CS_PRIMED)
@@ -274,8 +371,10 @@ void QDECL SV_SendServerCommand(client_t *cl, const char *fmt, ...)
 			continue;
 		}
 
-		SV_AddServerCommand(client, (char *)message);
+		SV_AddSharedServerCommand(client, command);
 	}
+
+	SV_ReleaseServerCommand(command);
 }
 
 /*
@@ -47,49 +47,16 @@
  */
 static void SV_Netchan_Encode(client_t *client, msg_t *msg, char *commandString)
 {
-	long     i, index;
-	byte     key, *string;
-	int      srdc, sbit;
-	qboolean soob;
-
 	if (msg->cursize < SV_ENCODE_START)
 	{
 		return;
 	}
 
-	// NOTE: saving pos, reading reliableAck, restoring, not using it .. useless?
-	srdc = msg->readcount;
-	sbit = msg->bit;
-	soob = msg->oob;
-
-	msg->bit       = 0;
-	msg->readcount = 0;
-	msg->oob       = qfalse;
-
-	MSG_ReadLong(msg);
-
-	msg->oob       = soob;
-	msg->bit       = sbit;
-	msg->readcount = srdc;
-
-	string = (byte *)commandString;
-	index  = 0;
 	// xor the client challenge with the netchan sequence number
-	key = client->challenge ^ client->netchan.outgoingSequence;
-	for (i = SV_ENCODE_START; i < msg->cursize; i++)
-	{
-		// modify the key with the last received and with this message acknowledged client command
-		if (!string[index])
-		{
-			index = 0;
-		}
-
-		key ^= string[index] << (i & 1);
-
-		index++;
-		// encode the data with this key
-		*(msg->data + i) = *(msg->data + i) ^ key;
-	}
+	// and modify the key with the last received and with this message acknowledged client command
+	Netchan_XorPayload(msg->data, SV_ENCODE_START, msg->cursize,
+	                   (byte)(client->challenge ^ client->netchan.outgoingSequence),
+	                   (const byte *)commandString, 0);
 }
 
 /**
@@ -105,12 +72,9 @@ static void SV_Netchan_Encode(client_t *client, msg_t *msg, char *commandString)
 static void SV_Netchan_Decode(client_t *client, msg_t *msg)
 {
 	int      serverId, messageAcknowledge, reliableAcknowledge;
-	int      i;
-	int      index = 0;
 	int      srdc = msg->readcount;
 	int      sbit = msg->bit;
 	qboolean soob = msg->oob;
-	byte     key, *string;
 
 	msg->oob = qfalse;
 
@@ -122,32 +86,67 @@ static void SV_Netchan_Decode(client_t *client, msg_t *msg)
 	msg->bit       = sbit;
 	msg->readcount = srdc;
 
-	string = (byte *)client->reliableCommands[reliableAcknowledge & (MAX_RELIABLE_COMMANDS - 1)];
+	// modify the key with the last sent and acknowledged server command,
+	// the command may be shared with other clients so it is keyed as the client saw it without modifying it
+	Netchan_XorPayload(msg->data, msg->readcount + SV_DECODE_START, msg->cursize,
+	                   (byte)(client->challenge ^ serverId ^ messageAcknowledge),
+	                   (const byte *)SV_GetServerCommand(client, reliableAcknowledge),
+	                   NETCHAN_STRIP_PERCENT | (Com_IsCompatible(&client->agent, 0x1) ? 0 : NETCHAN_STRIP_HIGH));
+}
+
+// number of sent queue buffers the server keeps for reuse, so stacking messages
+// behind a fragmented gamestate or snapshot doesn't churn the zone. The pool is
+// shared by all clients so idle connections don't hold on to any.
+#define NETCHAN_QUEUE_POOL 8
+
+/**
+ * @brief Gets a buffer for a message that has to be queued
+ * @param[in] client
+ * @return
+ */
+static netchan_buffer_t *SV_Netchan_AllocBuffer(client_t *client)
+{
+	netchan_buffer_t *netbuf = svs.netchanFreeQueue;
+
+	svs.stats.netchanQueued++;
+
+	if (netbuf)
+	{
+		svs.netchanFreeQueue = netbuf->next;
+		svs.netchanFreeCount--;
+		return netbuf;
+	}
+
+	svs.stats.netchanQueueAllocs++;
 
-	key = client->challenge ^ serverId ^ messageAcknowledge;
-	for (i = msg->readcount + SV_DECODE_START; i < msg->cursize; i++)
+	// the pool only runs dry when more messages are waiting than it holds
+	if (client->netchan_start_queue)
 	{
-		// modify the key with the last sent and acknowledged server command
-		if (!string[index])
-		{
-			index = 0;
-		}
-
-		if ((!Com_IsCompatible(&client->agent, 0x1) && (byte)string[index] > 127) || string[index] == '%')
-		{
-			string[index] = '.';
-		}
-
-		key ^= string[index] << (i & 1);
-
-		index++;
-		// decode the data with this key
-		*(msg->data + i) = *(msg->data + i) ^ key;
+		svs.stats.netchanQueueOverflows++;
 	}
+
+	return (netchan_buffer_t *)Z_Malloc(sizeof(netchan_buffer_t));
+}
+
+/**
+ * @brief Returns a sent buffer to the pool of the server
+ * @param[in] netbuf
+ */
+static void SV_Netchan_FreeBuffer(netchan_buffer_t *netbuf)
+{
+	if (svs.netchanFreeCount >= NETCHAN_QUEUE_POOL)
+	{
+		Z_Free(netbuf);
+		return;
+	}
+
+	netbuf->next         = svs.netchanFreeQueue;
+	svs.netchanFreeQueue = netbuf;
+	svs.netchanFreeCount++;
 }
 
 /**
- * @brief SV_Netchan_ClearQueue
+ * @brief Frees the queued messages of a client
  * @param[in,out] client
  */
 void SV_Netchan_ClearQueue(client_t *client)
@@ -157,13 +156,30 @@ void SV_Netchan_ClearQueue(client_t *client)
 	for (netbuf = client->netchan_start_queue; netbuf; netbuf = next)
 	{
 		next = netbuf->next;
-		Z_Free(netbuf);
+		SV_Netchan_FreeBuffer(netbuf);
 	}
 
 	client->netchan_start_queue = NULL;
 	client->netchan_end_queue   = &client->netchan_start_queue;
 }
 
+/**
+ * @brief Frees the queue buffer pool of the server
+ */
+void SV_Netchan_FreePool(void)
+{
+	netchan_buffer_t *netbuf, *next;
+
+	for (netbuf = svs.netchanFreeQueue; netbuf; netbuf = next)
+	{
+		next = netbuf->next;
+		Z_Free(netbuf);
+	}
+
+	svs.netchanFreeQueue = NULL;
+	svs.netchanFreeCount = 0;
+}
+
 /**
  * @brief SV_Netchan_TransmitNextInQueue
  * @param[in,out] client
@@ -191,7 +207,7 @@ void SV_Netchan_TransmitNextInQueue(client_t *client)
 		Com_DPrintf("Netchan_TransmitNextFragment: remaining queued message\n");
 	}
 
-	Z_Free(netbuf);
+	SV_Netchan_FreeBuffer(netbuf);
 }
 
 /**
@@ -259,7 +275,7 @@ void SV_Netchan_Transmit(client_t *client, msg_t *msg)
 	{
 		netchan_buffer_t *netbuf;
 		Com_DPrintf("SV_Netchan_Transmit: unsent fragments, stacked\n");
-		netbuf = (netchan_buffer_t *)Z_Malloc(sizeof(netchan_buffer_t));
+		netbuf = SV_Netchan_AllocBuffer(client);
 		// store the msg, we can't store it encoded, as the encoding depends on stuff we still have to finish sending
 		MSG_Copy(&netbuf->msg, netbuf->msgBuffer, sizeof(netbuf->msgBuffer), msg);
 		Q_strncpyz(netbuf->lastClientCommandString, client->lastClientCommandString, sizeof(netbuf->lastClientCommandString));
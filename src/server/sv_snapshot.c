@@ -56,13 +56,42 @@ A normal server packet will look like:
 =============================================================================
 */
 
+#define SNAPSHOT_DELTA_BUFFER   (MAX_MSGLEN * 4)    // deltas of a whole frame, before the budget cuts them
+
+static byte  snapshotDeltaData[SNAPSHOT_DELTA_BUFFER];
+static msg_t snapshotDeltas;
+static int   snapshotDeltaOffset[MAX_GENTITIES];
+static int   snapshotDeltaBits[MAX_GENTITIES];          // -1 if the delta didn't fit in snapshotDeltas
+static int   snapshotDeltaUncompressed[MAX_GENTITIES];
+
+/**
+ * @brief Copies the delta of an entity SV_PrioritiseSnapshotEntities encoded
+ * @param[in,out] msg
+ * @param[in] deltas
+ * @param[in] number
+ * @return qfalse if the delta has to be encoded
+ */
+static qboolean SV_WriteEncodedDelta(msg_t *msg, const msg_t *deltas, int number)
+{
+	if (snapshotDeltaBits[number] < 0)
+	{
+		return qfalse;
+	}
+
+	MSG_CopyBits(msg, deltas, snapshotDeltaOffset[number], snapshotDeltaBits[number]);
+	msg->uncompsize += snapshotDeltaUncompressed[number];   // net debugging
+
+	return qtrue;
+}
+
 /**
  * @brief Writes a delta update of an entityState_t list to the message.
  * @param[in] from
  * @param[in] to
  * @param[in] msg
+ * @param[in] deltas deltas SV_PrioritiseSnapshotEntities already encoded, NULL to encode them here
  */
-static void SV_EmitPacketEntities(clientSnapshot_t *from, clientSnapshot_t *to, msg_t *msg)
+static void SV_EmitPacketEntities(clientSnapshot_t *from, clientSnapshot_t *to, msg_t *msg, const msg_t *deltas)
 {
 	entityState_t *oldent = NULL, *newent = NULL;
 	int           oldindex = 0, newindex = 0;
@@ -106,7 +135,10 @@ static void SV_EmitPacketEntities(clientSnapshot_t *from, clientSnapshot_t *to,
 			// delta update from old position
 			// because the force parm is qfalse, this will not result
 			// in any bytes being emited if the entity has not changed at all
-			MSG_WriteDeltaEntity(msg, oldent, newent, qfalse);
+			if (!deltas || !SV_WriteEncodedDelta(msg, deltas, newnum))
+			{
+				MSG_WriteDeltaEntity(msg, oldent, newent, qfalse);
+			}
 			oldindex++;
 			newindex++;
 			continue;
@@ -120,7 +152,10 @@ static void SV_EmitPacketEntities(clientSnapshot_t *from, clientSnapshot_t *to,
 			}
 
 			// this is a new entity, send it from the baseline
-			MSG_WriteDeltaEntity(msg, &sv.svEntities[newnum].baseline, newent, qtrue);
+			if (!deltas || !SV_WriteEncodedDelta(msg, deltas, newnum))
+			{
+				MSG_WriteDeltaEntity(msg, &sv.svEntities[newnum].baseline, newent, qtrue);
+			}
 			newindex++;
 			continue;
 		}
@@ -137,6 +172,319 @@ static void SV_EmitPacketEntities(clientSnapshot_t *from, clientSnapshot_t *to,
 	MSG_WriteBits(msg, (MAX_GENTITIES - 1), GENTITYNUM_BITS);       // end of packetentities
 }
 
+/**
+ * @brief Returns the rate of a client clamped to sv_minRate and sv_maxRate
+ * @param[in] client
+ * @return bytes / second
+ */
+static int SV_ClientRate(client_t *client)
+{
+	int rate = client->rate;
+
+	if (sv_maxRate->integer)
+	{
+		if (sv_maxRate->integer < 1000)
+		{
+			Cvar_Set("sv_MaxRate", "1000");
+		}
+		if (sv_maxRate->integer < rate)
+		{
+			rate = sv_maxRate->integer;
+		}
+	}
+
+	if (sv_minRate->integer)
+	{
+		if (sv_minRate->integer < 1000)
+		{
+			Cvar_Set("sv_minRate", "1000");
+		}
+		if (sv_minRate->integer > rate)
+		{
+			rate = sv_minRate->integer;
+		}
+	}
+
+	return rate;
+}
+
+/**
+ * @brief Returns the interval between snapshots sent to a client
+ * @param[in] client
+ * @return msec between snapshots
+ */
+static int SV_SnapshotMsec(client_t *client)
+{
+	if (client->adaptiveSnapshotMsec > client->snapshotMsec)
+	{
+		return client->adaptiveSnapshotMsec;
+	}
+
+	return client->snapshotMsec;
+}
+
+#define SNAPSHOT_MIN_BUDGET     400     // bytes a prioritised snapshot may always use
+#define SNAPSHOT_MAX_DEFERRED   8       // snapshots an entity may be held back before it is forced through
+
+/**
+ * @struct snapshotCandidate_t
+ * @brief An entity update competing for the byte budget of a snapshot
+ */
+typedef struct
+{
+	entityState_t *newent;
+	entityState_t *oldent;              ///< state the client has, NULL if the entity is new to it
+	int bits;                           ///< size of the delta
+	float score;
+} snapshotCandidate_t;
+
+static snapshotCandidate_t snapshotCandidates[MAX_GENTITIES];   // a frame holds each entity once
+
+/**
+ * @brief Sorts snapshot candidates by descending score
+ * @param[in] a
+ * @param[in] b
+ * @return
+ */
+static int QDECL SV_QsortSnapshotCandidates(const void *a, const void *b)
+{
+	float sa = ((const snapshotCandidate_t *)a)->score;
+	float sb = ((const snapshotCandidate_t *)b)->score;
+
+	if (sa > sb)
+	{
+		return -1;
+	}
+	if (sa < sb)
+	{
+		return 1;
+	}
+	return 0;
+}
+
+/**
+ * @brief Scores an entity update for a client, higher goes first
+ * @param[in] client
+ * @param[in] frame
+ * @param[in] forward view direction of the client
+ * @param[in] ent
+ * @return
+ */
+static float SV_SnapshotEntityScore(client_t *client, clientSnapshot_t *frame, vec3_t forward, entityState_t *ent)
+{
+	vec3_t delta;
+	float  score, dist;
+
+	if (ent->number < sv_maxclients->integer || ent->eType == ET_PLAYER)
+	{
+		score = 4.f;
+	}
+	else if (ent->eType == ET_MISSILE)
+	{
+		score = 3.f;
+	}
+	else
+	{
+		score = 1.f;
+	}
+
+	VectorSubtract(ent->pos.trBase, frame->ps.origin, delta);
+	dist = VectorNormalize(delta);
+
+	score /= 1.f + dist / 512.f;
+
+	// favour what the client is looking at
+	if (DotProduct(delta, forward) > 0.5f)
+	{
+		score *= 2.f;
+	}
+	else if (DotProduct(delta, forward) < 0.f)
+	{
+		score *= 0.5f;
+	}
+
+	// and what it hasn't been told about for a while
+	return score * (1 + client->snapshotDeferred[ent->number]);
+}
+
+/**
+ * @brief Fits the entity updates of a snapshot into a byte budget
+ *
+ * Entity deltas are encoded once into snapshotDeltas, sized, then sent by
+ * priority until the budget is spent. SV_EmitPacketEntities copies the
+ * encoded deltas instead of encoding them again. A deferred entity the client
+ * already knows keeps the state the client has, so it emits nothing and delta
+ * compression stays valid, a deferred new entity is left out of the frame.
+ * Removals, events, movers and entities held back for SNAPSHOT_MAX_DEFERRED
+ * snapshots always go out.
+ *
+ * @param[in,out] client
+ * @param[in] from
+ * @param[in,out] to
+ * @param[in] budget bytes left in the packet for entities
+ */
+static void SV_PrioritiseSnapshotEntities(client_t *client, clientSnapshot_t *from, clientSnapshot_t *to, int budget)
+{
+	static byte         buf[MAX_MSGLEN];
+	msg_t               scratch;
+	snapshotCandidate_t *cand;
+	entityState_t       *oldent, *newent;
+	vec3_t              forward;
+	int                 oldindex = 0, newindex, numCandidates = 0, numEntities, i, bits, uncompressed;
+	int                 from_num_entities = from ? from->num_entities : 0;
+
+	budget = budget > SNAPSHOT_MIN_BUDGET ? budget * 8 : SNAPSHOT_MIN_BUDGET * 8;
+
+	// no MSG_Init, the writes clear each byte as they reach it
+	Com_Memset(&snapshotDeltas, 0, sizeof(snapshotDeltas));
+	snapshotDeltas.data          = snapshotDeltaData;
+	snapshotDeltas.maxsize       = sizeof(snapshotDeltaData);
+	snapshotDeltas.allowoverflow = qtrue;
+
+	angles_vectors(to->ps.viewangles, forward, NULL, NULL);
+
+	for (newindex = 0; newindex < to->num_entities; newindex++)
+	{
+		newent = &svs.snapshotEntities[(to->first_entity + newindex) % svs.numSnapshotEntities];
+		oldent = NULL;
+
+		for ( ; oldindex < from_num_entities; oldindex++)
+		{
+			oldent = &svs.snapshotEntities[(from->first_entity + oldindex) % svs.numSnapshotEntities];
+
+			if (oldent->number >= newent->number)
+			{
+				break;
+			}
+
+			budget -= GENTITYNUM_BITS + 1;          // removal
+		}
+
+		if (oldindex >= from_num_entities || oldent->number != newent->number)
+		{
+			oldent = NULL;
+		}
+		else
+		{
+			oldindex++;
+		}
+
+		snapshotDeltaOffset[newent->number] = snapshotDeltas.bit;
+		uncompressed                        = snapshotDeltas.uncompsize;
+
+		if (oldent)
+		{
+			MSG_WriteDeltaEntity(&snapshotDeltas, oldent, newent, qfalse);
+		}
+		else
+		{
+			MSG_WriteDeltaEntity(&snapshotDeltas, &sv.svEntities[newent->number].baseline, newent, qtrue);
+		}
+
+		if (!snapshotDeltas.overflowed)
+		{
+			bits                                      = snapshotDeltas.bit - snapshotDeltaOffset[newent->number];
+			snapshotDeltaBits[newent->number]         = bits;
+			snapshotDeltaUncompressed[newent->number] = snapshotDeltas.uncompsize - uncompressed;
+		}
+		else
+		{
+			// out of room, size it alone and leave it to SV_EmitPacketEntities
+			MSG_Init(&scratch, buf, sizeof(buf));
+			scratch.allowoverflow = qtrue;
+
+			if (oldent)
+			{
+				MSG_WriteDeltaEntity(&scratch, oldent, newent, qfalse);
+			}
+			else
+			{
+				MSG_WriteDeltaEntity(&scratch, &sv.svEntities[newent->number].baseline, newent, qtrue);
+			}
+
+			bits                              = scratch.bit;
+			snapshotDeltaBits[newent->number] = -1;
+		}
+
+		if (!bits)
+		{
+			client->snapshotDeferred[newent->number] = 0;
+			continue;
+		}
+
+		// a mover held back leaves the players riding it out of step
+		if (newent->eType >= ET_EVENTS || newent->eType == ET_MOVER || (oldent && oldent->event != newent->event)
+		    || client->snapshotDeferred[newent->number] >= SNAPSHOT_MAX_DEFERRED)
+		{
+			budget                                  -= bits;
+			client->snapshotDeferred[newent->number] = 0;
+			continue;
+		}
+
+		cand         = &snapshotCandidates[numCandidates++];
+		cand->newent = newent;
+		cand->oldent = oldent;
+		cand->bits   = bits;
+		cand->score  = SV_SnapshotEntityScore(client, to, forward, newent);
+	}
+
+	// removals after the last entity of the frame
+	budget -= (from_num_entities - oldindex) * (GENTITYNUM_BITS + 1);
+
+	qsort(snapshotCandidates, numCandidates, sizeof(snapshotCandidates[0]), SV_QsortSnapshotCandidates);
+
+	numEntities = to->num_entities;
+
+	for (i = 0; i < numCandidates; i++)
+	{
+		cand = &snapshotCandidates[i];
+
+		if (cand->bits <= budget)
+		{
+			budget                                        -= cand->bits;
+			client->snapshotDeferred[cand->newent->number] = 0;
+			continue;
+		}
+
+		client->snapshotDeferred[cand->newent->number]++;
+
+		if (cand->oldent)
+		{
+			*cand->newent                           = *cand->oldent;
+			snapshotDeltaBits[cand->newent->number] = 0;    // unchanged, emits nothing
+		}
+		else
+		{
+			cand->newent->number = MAX_GENTITIES;   // dropped below
+			numEntities--;
+		}
+	}
+
+	if (numEntities == to->num_entities)
+	{
+		return;
+	}
+
+	// squeeze deferred new entities out of the frame, keeping the order
+	for (newindex = 0, i = 0; newindex < to->num_entities; newindex++)
+	{
+		newent = &svs.snapshotEntities[(to->first_entity + newindex) % svs.numSnapshotEntities];
+
+		if (newent->number == MAX_GENTITIES)
+		{
+			continue;
+		}
+
+		if (i != newindex)
+		{
+			svs.snapshotEntities[(to->first_entity + i) % svs.numSnapshotEntities] = *newent;
+		}
+		i++;
+	}
+
+	to->num_entities = numEntities;
+}
+
 /**
  * @brief SV_WriteSnapshotToClient
  * @param[in] client
@@ -226,8 +574,21 @@ static void SV_WriteSnapshotToClient(client_t *client, msg_t *msg)
 	//Com_Printf( "Playerstate delta size: %f\n", ((msg->cursize - sz) * sv_fps->integer) / 8.f );
 	//}
 
-	// delta encode the entities
-	SV_EmitPacketEntities(oldframe, frame, msg);
+	// squeeze the entities into what the client's rate allows per snapshot
+	if (sv_snapshotPriority->integer && client->state == CS_ACTIVE
+	    && client->netchan.remoteAddress.type != NA_LOOPBACK)
+	{
+		SV_PrioritiseSnapshotEntities(client, oldframe, frame,
+		                              SV_ClientRate(client) * SV_SnapshotMsec(client) / 1000 - msg->cursize);
+
+		// delta encode the entities, reusing what the prioritiser encoded
+		SV_EmitPacketEntities(oldframe, frame, msg, &snapshotDeltas);
+	}
+	else
+	{
+		// delta encode the entities
+		SV_EmitPacketEntities(oldframe, frame, msg, NULL);
+	}
 
 	// padding for rate debugging
 	if (sv_padPackets->integer)
@@ -255,7 +616,7 @@ void SV_UpdateServerCommandsToClient(client_t *client, msg_t *msg)
 	{
 		MSG_WriteByte(msg, svc_serverCommand);
 		MSG_WriteLong(msg, i);
-		MSG_WriteString(msg, client->reliableCommands[i & (MAX_RELIABLE_COMMANDS - 1)]);
+		MSG_WriteString(msg, SV_GetServerCommand(client, i));
 	}
 
 	client->reliableSent = client->reliableSequence;
@@ -760,76 +1121,159 @@ static void SV_BuildClientSnapshot(client_t *client)
 	}
 }
 
-#define UDPIP_HEADER_SIZE 28
-#define UDPIP6_HEADER_SIZE 48
+#define RATE_BURST_MSEC 10      // how long an idle client may save up send credit
 
 /**
  * @brief Return the number of msec until another message can be sent to
  * a client based on its rate settings
  *
- * @param[in] client
+ * Rate is enforced with a token bucket refilled on a microsecond clock and
+ * charged with the bytes the netchan actually sent (UDP/IP headers included),
+ * so sub-millisecond remainders carry over instead of being rounded away.
+ *
+ * @param[in,out] client
  *
  * @return The number of msec
  */
 int SV_RateMsec(client_t *client)
 {
-	int rate, rateMsec;
-	int messageSize;
+	int     rate;
+	int64_t now, burst, wait;
 
-	messageSize = client->netchan.lastSentSize;
-	rate        = client->rate;
+	rate = SV_ClientRate(client);
 
-	if (sv_maxRate->integer)
+	if (com_timescale->value > 0.f)
 	{
-		if (sv_maxRate->integer < 1000)
+		rate = (int)(rate * com_timescale->value);
+	}
+
+	if (rate < 1)
+	{
+		rate = 1;
+	}
+
+	now   = Sys_Microseconds();
+	burst = (int64_t)rate * RATE_BURST_MSEC * 1000;
+
+	// charge everything the netchan put on the wire since the last call
+	// before refilling, so the time that paid for it isn't capped away
+	client->rateCredit   -= (int64_t)(client->netchan.sentBytes - client->rateSentBytes) * 1000000;
+	client->rateSentBytes = client->netchan.sentBytes;
+
+	if (!client->rateTime)
+	{
+		// start with a full bucket
+		client->rateCredit = burst;
+	}
+	else
+	{
+		client->rateCredit += (now - client->rateTime) * rate;
+
+		if (client->rateCredit > burst)
 		{
-			Cvar_Set("sv_MaxRate", "1000");
+			client->rateCredit = burst;
 		}
-		if (sv_maxRate->integer < rate)
+	}
+	client->rateTime = now;
+
+	if (client->rateCredit >= 0)
+	{
+		return 0;
+	}
+
+	// round up so the caller never wakes before the debt is paid
+	wait = (-client->rateCredit + rate - 1) / rate;
+
+	return (int)((wait + 999) / 1000);
+}
+
+#define ADAPTIVE_SNAPSHOT_CHECK 1000    // msec between re-evaluations of a client's snapshot interval
+#define ADAPTIVE_SNAPSHOT_SLACK 100     // msec on top of the ping before an unacked snapshot counts as lost
+
+/**
+ * @brief Re-evaluates the snapshot interval of a client for sv_adaptiveSnapshots
+ *
+ * A snapshot is considered lost when it was sent longer than ping + slack ago
+ * and neither it nor any later snapshot has been acknowledged (the client only
+ * acks the newest one it got). Loss or rate chokes since the last check slow
+ * the client down, a clean link brings it back towards its requested snaps.
+ *
+ * @param[in,out] client
+ */
+static void SV_AdaptSnapshotRate(client_t *client)
+{
+	clientSnapshot_t *frame;
+	int              i, sent = 0, lost = 0, lastAcked = -1, since, timeout, maxMsec;
+
+	if (!sv_adaptiveSnapshots->integer || client->state != CS_ACTIVE)
+	{
+		client->adaptiveSnapshotMsec = 0;
+		client->rateChokes           = 0;
+		return;
+	}
+
+	if (client->adaptiveSnapshotMsec && svs.time - client->adaptiveCheckTime < ADAPTIVE_SNAPSHOT_CHECK)
+	{
+		return;
+	}
+
+	since   = client->adaptiveCheckTime - client->ping - ADAPTIVE_SNAPSHOT_SLACK;
+	timeout = svs.time - client->ping - ADAPTIVE_SNAPSHOT_SLACK;
+
+	for (i = 0; i < PACKET_BACKUP; i++)
+	{
+		frame = &client->frames[i];
+
+		if (frame->messageAcked > 0 && frame->messageSent > lastAcked)
 		{
-			rate = sv_maxRate->integer;
+			lastAcked = frame->messageSent;
 		}
 	}
 
-	if (sv_minRate->integer)
+	for (i = 0; i < PACKET_BACKUP; i++)
 	{
-		if (sv_minRate->integer < 1000)
+		frame = &client->frames[i];
+
+		// only judge what was sent during the last period and had time to be acked
+		if (frame->messageSent <= since || frame->messageSent > timeout)
 		{
-			Cvar_Set("sv_minRate", "1000");
+			continue;
 		}
-		if (sv_minRate->integer > rate)
+
+		sent++;
+
+		if (frame->messageAcked == -1 && frame->messageSent > lastAcked)
 		{
-			rate = sv_minRate->integer;
+			lost++;
 		}
 	}
 
-	if (client->netchan.remoteAddress.type == NA_IP6)
+	maxMsec = client->snapshotMsec * 4;
+
+	if (!client->adaptiveSnapshotMsec)
 	{
-		messageSize += UDPIP6_HEADER_SIZE;
+		client->adaptiveSnapshotMsec = client->snapshotMsec;
 	}
-	else
+	else if (client->rateChokes || lost)
 	{
-		messageSize += UDPIP_HEADER_SIZE;
+		client->adaptiveSnapshotMsec += client->snapshotMsec / 2 + 1;
 	}
-
-	if (com_timescale->value > 0.f)
+	else if (sent)
 	{
-		rateMsec = messageSize * 1000 / ((int)(rate * com_timescale->value));
+		client->adaptiveSnapshotMsec -= client->snapshotMsec / 4 + 1;
 	}
-	else
-	{
-		rateMsec = messageSize * 1000 / rate;
-	}
-	rate = Sys_Milliseconds() - client->netchan.lastSentTime;
 
-	if (rate > rateMsec)
+	if (client->adaptiveSnapshotMsec > maxMsec)
 	{
-		return 0;
+		client->adaptiveSnapshotMsec = maxMsec;
 	}
-	else
+	if (client->adaptiveSnapshotMsec < client->snapshotMsec)
 	{
-		return rateMsec - rate;
+		client->adaptiveSnapshotMsec = client->snapshotMsec;
 	}
+
+	client->adaptiveCheckTime = svs.time;
+	client->rateChokes        = 0;
 }
 
 /**
@@ -990,7 +1434,9 @@ void SV_SendClientMessages(void)
 			continue;
 		}
 
-		if (svs.time - c->lastSnapshotTime < c->snapshotMsec * com_timescale->value)
+		SV_AdaptSnapshotRate(c);
+
+		if (svs.time - c->lastSnapshotTime < SV_SnapshotMsec(c) * com_timescale->value)
 		{
 			continue;       // It's not time yet
 		}
@@ -1024,6 +1470,7 @@ void SV_SendClientMessages(void)
 			{
 				// Not enough time since last packet passed through the line
 				c->rateDelayed = qtrue;
+				c->rateChokes++;
 				continue;
 			}
 		}
@@ -1112,3 +1559,391 @@ void SV_CheckClientUserinfoTimer(void)
 		}
 	}
 }
+
+/**
+ * @struct netBenchClient_s
+ * @typedef netBenchClient_t
+ * @brief A client slot driven by netbench
+ */
+typedef struct netBenchClient_s
+{
+	client_t *cl;
+	netchan_t chan;                 ///< receiving end of the loopback
+	playerState_t savedPs;          ///< game playerstate of the unused slot
+	vec3_t view;                    ///< origin the snapshots are built from
+} netBenchClient_t;
+
+/**
+ * @brief Reads the packets netbench sent over the loopback
+ * @param[in,out] fake
+ * @param[in,out] msg
+ * @param[in,out] packets
+ * @return qtrue if a complete message came in
+ */
+static qboolean SV_NetBenchReceive(netBenchClient_t *fake, msg_t *msg, int *packets)
+{
+	netadr_t from;
+	qboolean received = qfalse;
+
+	while (NET_GetLoopPacket(NS_CLIENT, &from, msg))
+	{
+		(*packets)++;
+		if (Netchan_Process(&fake->chan, msg))
+		{
+			received = qtrue;
+		}
+	}
+
+	return received;
+}
+
+/**
+ * @brief Runs server frames and sends the snapshots of a number of fake clients over the loopback
+ *
+ * The fake clients take free slots and view the world from the origins of linked
+ * entities spread over the map. They sit out SV_Frame, which runs the game and
+ * serves the real clients, and then get a snapshot each through the normal build,
+ * write and netchan code. The receiving end reassembles the packets and acks them
+ * right away, so every snapshot after the first is a delta to the previous one.
+ *
+ * @param[in] iterations
+ * @param[in] count
+ *
+ * @note The fake clients are loopback clients, so like a local player their
+ * snapshots are not squeezed by sv_snapshotPriority.
+ */
+static void SV_NetBenchFakeClients(int iterations, int count)
+{
+	static byte      msg_buf[MAX_MSGLEN];
+	static byte      recv_buf[MAX_MSGLEN];
+	netBenchClient_t *fakes, *fake;
+	msg_t            msg, recv;
+	netadr_t         adr, from;
+	client_t         *cl;
+	playerState_t    *ps;
+	sharedEntity_t   *ent;
+	int64_t          start, timeFrame = 0, timeBuild = 0, timeWrite = 0, timeNetchan = 0, bytes = 0;
+	int              i, j, n, view, numFakes = 0, numViews = 0, frames = 0, snapshots = 0, deltas = 0, packets = 0;
+	int              frameMsec, lastTime;
+	qboolean         received;
+
+	for (i = 0, cl = svs.clients; i < sv_maxclients->integer; i++, cl++)
+	{
+		if (cl->state >= CS_CONNECTED && cl->netchan.remoteAddress.type == NA_LOOPBACK)
+		{
+			Com_Printf("netbench: fake clients use the loopback, disconnect the local client first\n");
+			return;
+		}
+	}
+
+	for (i = 0; i < sv.num_entities; i++)
+	{
+		if (SV_GentityNum(i)->r.linked)
+		{
+			numViews++;
+		}
+	}
+
+	fakes = Z_Malloc(count * sizeof(*fakes));
+
+	Com_Memset(&adr, 0, sizeof(adr));
+	adr.type = NA_LOOPBACK;
+
+	MSG_Init(&recv, recv_buf, sizeof(recv_buf));
+	while (NET_GetLoopPacket(NS_CLIENT, &from, &recv))
+	{
+	}
+
+	for (i = 0, cl = svs.clients; i < sv_maxclients->integer && numFakes < count; i++, cl++)
+	{
+		if (cl->state != CS_FREE)
+		{
+			continue;
+		}
+
+		fake     = &fakes[numFakes++];
+		fake->cl = cl;
+
+		Com_Memset(cl, 0, sizeof(*cl));
+		SV_Netchan_ClearQueue(cl);
+		Com_sprintf(cl->name, sizeof(cl->name), "netbench%i", numFakes);
+		cl->gentity      = SV_GentityNum(i);
+		cl->deltaMessage = -1;
+		Netchan_Setup(NS_SERVER, &cl->netchan, adr, i);
+		Netchan_Setup(NS_CLIENT, &fake->chan, adr, i);
+
+		ps            = SV_GameClientNum(i);
+		fake->savedPs = *ps;
+
+		// spread the viewpoints over the linked entities
+		view = numViews * (numFakes - 1) / count;
+		for (j = 0; j < sv.num_entities; j++)
+		{
+			ent = SV_GentityNum(j);
+			if (ent->r.linked && view-- == 0)
+			{
+				VectorCopy(ent->r.currentOrigin, fake->view);
+				break;
+			}
+		}
+	}
+
+	if (!numFakes)
+	{
+		Com_Printf("netbench: no free client slots for fake clients\n");
+		Z_Free(fakes);
+		return;
+	}
+
+	frameMsec = 1000 / MAX(sv_fps->integer, 1);
+
+	for (n = 0; n < iterations; n++)
+	{
+		// the game doesn't know the fake clients, keep them out of the server frame
+		for (i = 0; i < numFakes; i++)
+		{
+			fakes[i].cl->state = CS_FREE;
+		}
+
+		lastTime = svs.time;
+
+		start = Sys_Microseconds();
+		SV_Frame(frameMsec);
+		timeFrame += Sys_Microseconds() - start;
+
+		if (!com_sv_running->integer)
+		{
+			// the client slots are gone
+			Z_Free(fakes);
+			Com_Printf("netbench: server stopped\n");
+			return;
+		}
+
+		for (i = 0; i < numFakes; i++)
+		{
+			if (fakes[i].cl->state != CS_FREE)
+			{
+				// a bot was put into the slot, leave it alone
+				fakes[i].cl = NULL;
+			}
+		}
+
+		if (svs.time == lastTime)
+		{
+			Com_Printf("netbench: server frame didn't run (paused or restarting)\n");
+			break;
+		}
+		frames++;
+
+		for (i = 0, fake = fakes; i < numFakes; i++, fake++)
+		{
+			cl = fake->cl;
+			if (!cl)
+			{
+				continue;
+			}
+
+			cl->state          = CS_ACTIVE;
+			cl->lastPacketTime = svs.time;
+
+			ps = SV_GameClientNum(cl - svs.clients);
+			Com_Memset(ps, 0, sizeof(*ps));
+			ps->clientNum   = cl - svs.clients;
+			ps->commandTime = svs.time;
+			VectorCopy(fake->view, ps->origin);
+
+			start = Sys_Microseconds();
+			SV_BuildClientSnapshot(cl);
+			timeBuild += Sys_Microseconds() - start;
+
+			MSG_Init(&msg, msg_buf, sizeof(msg_buf));
+			msg.allowoverflow = qtrue;
+
+			start = Sys_Microseconds();
+			MSG_WriteLong(&msg, cl->lastClientCommand);
+			SV_UpdateServerCommandsToClient(cl, &msg);
+			SV_WriteSnapshotToClient(cl, &msg);
+			timeWrite += Sys_Microseconds() - start;
+
+			snapshots++;
+			bytes += msg.cursize;
+			if (cl->deltaMessage > 0)
+			{
+				deltas++;
+			}
+
+			// the loopback only holds a few packets, read every fragment right away
+			start = Sys_Microseconds();
+			SV_SendMessageToClient(&msg, cl);
+			received = SV_NetBenchReceive(fake, &recv, &packets);
+			while (cl->netchan.unsentFragments)
+			{
+				SV_Netchan_TransmitNextFragment(cl);
+				received |= SV_NetBenchReceive(fake, &recv, &packets);
+			}
+			timeNetchan += Sys_Microseconds() - start;
+
+			// ack it the way the next usercmd would
+			if (received)
+			{
+				cl->frames[fake->chan.incomingSequence & PACKET_MASK].messageAcked = svs.time;
+				cl->messageAcknowledge = fake->chan.incomingSequence;
+				cl->deltaMessage       = fake->chan.incomingSequence;
+			}
+		}
+	}
+
+	for (i = 0, fake = fakes; i < numFakes; i++, fake++)
+	{
+		cl = fake->cl;
+		if (!cl)
+		{
+			continue;
+		}
+
+		*SV_GameClientNum(cl - svs.clients) = fake->savedPs;
+		SV_Netchan_ClearQueue(cl);
+		Com_Memset(cl, 0, sizeof(*cl));
+	}
+
+	while (NET_GetLoopPacket(NS_CLIENT, &from, &recv))
+	{
+	}
+
+	Z_Free(fakes);
+
+	if (!snapshots)
+	{
+		return;
+	}
+
+	Com_Printf("netbench: %i fake clients, %i frames, %i snapshots (%i delta)\n", numFakes, frames, snapshots, deltas);
+	Com_Printf("phase   usec/snap\n");
+	Com_Printf("build   %9.2f\n", (double)timeBuild / snapshots);
+	Com_Printf("write   %9.2f\n", (double)timeWrite / snapshots);
+	Com_Printf("netchan %9.2f\n", (double)timeNetchan / snapshots);
+	Com_Printf("frame   %9.2f usec/frame (game and real clients)\n", (double)timeFrame / frames);
+	Com_Printf("bytes/snap: %i avg\n", (int)(bytes / snapshots));
+	Com_Printf("packets/snap: %.2f\n", (double)packets / snapshots);
+	if (timeBuild + timeWrite + timeNetchan > 0)
+	{
+		Com_Printf("snapshots/sec: %.0f, packets/sec: %.0f\n",
+		           snapshots * 1000000.0 / (timeBuild + timeWrite + timeNetchan),
+		           packets * 1000000.0 / (timeBuild + timeWrite + timeNetchan));
+	}
+}
+
+/**
+ * @brief Times snapshot generation for the clients on the server
+ *
+ * netbench [iterations] [fakeclients]
+ *
+ * Builds, encodes and obfuscates a snapshot for every active client (bots
+ * included) the given number of times without sending anything, and prints
+ * the time spent per phase, the bytes per client and how many snapshots and
+ * packets per second that would allow. With fake clients it then runs as many
+ * server frames and sends their snapshots over the loopback, see
+ * SV_NetBenchFakeClients. Run it on a server with a fixed set of bots for
+ * reproducible numbers when touching msg.c, huffman.c or this file.
+ *
+ * @note The benchmark uses up snapshot entities, real clients may get one
+ * non delta snapshot afterwards. The server frames of the fake client pass
+ * run back to back, real clients see the server time jump ahead.
+ */
+void SV_NetBench_f(void)
+{
+	static byte deferred[MAX_GENTITIES];
+	byte        msg_buf[MAX_MSGLEN];
+	msg_t       msg;
+	client_t    *cl;
+	int64_t     start, timeBuild = 0, timeWrite = 0, timeXor = 0, bytes = 0;
+	int         iterations, fakes, i, n, snapshots = 0, packets = 0, minBytes = MAX_MSGLEN, maxBytes = 0;
+
+	if (!com_sv_running->integer)
+	{
+		Com_Printf("Server is not running.\n");
+		return;
+	}
+
+	iterations = Cmd_Argc() > 1 ? Q_atoi(Cmd_Argv(1)) : 100;
+	fakes      = Cmd_Argc() > 2 ? Q_atoi(Cmd_Argv(2)) : 0;
+	if (iterations < 1 || fakes < 0)
+	{
+		Com_Printf("Usage: netbench [iterations] [fakeclients]\n");
+		return;
+	}
+
+	for (i = 0; i < sv_maxclients->integer; i++)
+	{
+		cl = &svs.clients[i];
+
+		if (cl->state != CS_ACTIVE || !cl->gentity || cl->demoClient)
+		{
+			continue;
+		}
+
+		// don't let the benchmark age entities in prioritised snapshots
+		Com_Memcpy(deferred, cl->snapshotDeferred, sizeof(deferred));
+
+		for (n = 0; n < iterations; n++)
+		{
+			start = Sys_Microseconds();
+			SV_BuildClientSnapshot(cl);
+			timeBuild += Sys_Microseconds() - start;
+
+			MSG_Init(&msg, msg_buf, sizeof(msg_buf));
+			msg.allowoverflow = qtrue;
+
+			start = Sys_Microseconds();
+			MSG_WriteLong(&msg, cl->lastClientCommand);
+			SV_WriteSnapshotToClient(cl, &msg);
+			timeWrite += Sys_Microseconds() - start;
+
+			start = Sys_Microseconds();
+			Netchan_XorPayload(msg.data, 4, msg.cursize, (byte)(cl->challenge ^ cl->netchan.outgoingSequence),
+			                   (const byte *)cl->lastClientCommandString, 0);
+			timeXor += Sys_Microseconds() - start;
+
+			snapshots++;
+			packets += msg.cursize >= FRAGMENT_SIZE ? msg.cursize / FRAGMENT_SIZE + 1 : 1;
+			bytes   += msg.cursize;
+			if (msg.cursize < minBytes)
+			{
+				minBytes = msg.cursize;
+			}
+			if (msg.cursize > maxBytes)
+			{
+				maxBytes = msg.cursize;
+			}
+		}
+
+		Com_Memcpy(cl->snapshotDeferred, deferred, sizeof(deferred));
+	}
+
+	if (snapshots)
+	{
+		Com_Printf("netbench: %i snapshots, %i iterations\n", snapshots, iterations);
+		Com_Printf("phase   usec/snap\n");
+		Com_Printf("build   %9.2f\n", (double)timeBuild / snapshots);
+		Com_Printf("write   %9.2f\n", (double)timeWrite / snapshots);
+		Com_Printf("xor     %9.2f\n", (double)timeXor / snapshots);
+		Com_Printf("bytes/snap: %i avg, %i min, %i max\n", (int)(bytes / snapshots), minBytes, maxBytes);
+		Com_Printf("packets/snap: %.2f\n", (double)packets / snapshots);
+		if (timeBuild + timeWrite + timeXor > 0)
+		{
+			Com_Printf("snapshots/sec: %.0f, packets/sec: %.0f\n",
+			           snapshots * 1000000.0 / (timeBuild + timeWrite + timeXor),
+			           packets * 1000000.0 / (timeBuild + timeWrite + timeXor));
+		}
+	}
+	else if (!fakes)
+	{
+		Com_Printf("netbench: no active clients, add some bots or fake clients first\n");
+		return;
+	}
+
+	if (fakes)
+	{
+		SV_NetBenchFakeClients(iterations, MIN(fakes, MAX_CLIENTS));
+	}
+}
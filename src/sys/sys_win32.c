@@ -162,6 +162,30 @@ int Sys_Milliseconds(void)
 	return sys_curtime;
 }
 
+/**
+ * @brief Sys_Microseconds
+ * @return current system time in usec since the first call
+ */
+int64_t Sys_Microseconds(void)
+{
+	static LARGE_INTEGER frequency;
+	static LARGE_INTEGER base;
+	LARGE_INTEGER        counter;
+
+	if (!frequency.QuadPart)
+	{
+		QueryPerformanceFrequency(&frequency);
+		QueryPerformanceCounter(&base);
+	}
+
+	QueryPerformanceCounter(&counter);
+	counter.QuadPart -= base.QuadPart;
+
+	// split the division so the multiplication can't overflow on long uptimes
+	return (counter.QuadPart / frequency.QuadPart) * 1000000
+	       + (counter.QuadPart % frequency.QuadPart) * 1000000 / frequency.QuadPart;
+}
+
 /**
  * @brief Sys_SnapVector
  * @param[in,out] v
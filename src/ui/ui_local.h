@@ -682,6 +682,8 @@ typedef struct
 	qhandle_t modFilter_unknown;
 
 	qhandle_t campaignMap;
+
+	int translationGeneration;          ///< language generation of the engine, read once a frame for UI_TranslateString
 } uiInfo_t;
 
 extern uiInfo_t uiInfo;
@@ -712,6 +714,7 @@ void trap_Error(const char *fmt) _attribute((noreturn));
 int trap_Milliseconds(void);
 void trap_Cvar_Register(vmCvar_t *vmCvar, const char *varName, const char *defaultValue, int flags);
 void trap_Cvar_Update(vmCvar_t *vmCvar);
+void UI_InitExtensionTraps(void);
 void trap_Cvar_Set(const char *varName, const char *value);
 float trap_Cvar_VariableValue(const char *varName);
 void trap_Cvar_VariableStringBuffer(const char *varName, char *buffer, int bufsize);
@@ -809,6 +812,7 @@ void trap_GetHunkData(int *hunkused, int *hunkexpected);
 // localization functions
 const char *UI_TranslateString(const char *string);
 void trap_TranslateString(const char *fmt, char *buffer);
+int trap_TranslationGeneration(void);
 
 const char *UI_DescriptionForCampaign(void);
 const char *UI_NameForCampaign(void);
@@ -968,6 +968,9 @@ void UI_Refresh(int realtime)
 	uiInfo.uiDC.frameTime = realtime - uiInfo.uiDC.realTime;
 	uiInfo.uiDC.realTime  = realtime;
 
+	// a language change takes effect in the next frame
+	uiInfo.translationGeneration = trap_TranslationGeneration();
+
 	previousTimes[index % UI_FPS_FRAMES] = uiInfo.uiDC.frameTime;
 	index++;
 	if (index > UI_FPS_FRAMES)
@@ -8571,6 +8574,10 @@ void UI_Init(int etLegacyClient, int clientVersion)
 
 	MOD_CHECK_ETLEGACY(etLegacyClient, clientVersion, uiInfo.etLegacyClient);
 
+	UI_InitExtensionTraps();
+
+	uiInfo.translationGeneration = trap_TranslationGeneration();
+
 	uiInfo.uiDC.etLegacyClient = uiInfo.etLegacyClient;
 
 	if (uiInfo.etLegacyClient <= 0)
@@ -9402,6 +9409,8 @@ static cvarTable_t cvarTable[] =
 
 static const unsigned int cvarTableSize = sizeof(cvarTable) / sizeof(cvarTable[0]);
 
+static bgCvarChanges_t cvarChanges;
+
 /**
  * @brief UI_RegisterCvars
  */
@@ -9412,11 +9421,14 @@ void UI_RegisterCvars(void)
 
 	Com_Printf("%u UI cvars in use\n", cvarTableSize);
 
+	Com_Memset(&cvarChanges, 0, sizeof(cvarChanges));
+
 	for (i = 0, cv = cvarTable ; i < cvarTableSize ; i++, cv++)
 	{
 		trap_Cvar_Register(cv->vmCvar, cv->cvarName, cv->defaultString, cv->cvarFlags);
 		if (cv->vmCvar != NULL)
 		{
+			BG_CvarChangesRegister(&cvarChanges, i, cv->vmCvar);
 			cv->modificationCount = cv->vmCvar->modificationCount;
 		}
 	}
@@ -9432,11 +9444,17 @@ void UI_RegisterCvars(void)
  */
 void UI_UpdateCvars(void)
 {
-	size_t      i;
+	int         i, numChanges;
+	int         changes[ARRAY_LEN(cvarTable)];
 	cvarTable_t *cv;
 
-	for (i = 0, cv = cvarTable ; i < cvarTableSize ; i++, cv++)
+	// only visit the cvars which changed, if the engine tells us
+	numChanges = BG_CvarChangesGet(&cvarChanges, changes, cvarTableSize);
+
+	for (i = 0 ; i < numChanges ; i++)
 	{
+		cv = &cvarTable[changes[i]];
+
 		if (cv->vmCvar)
 		{
 			trap_Cvar_Update(cv->vmCvar);
@@ -9812,10 +9830,24 @@ const char *UI_TranslateString(const char *string)
 	static char buffer[TRANSLATION_BUFFERS][MAX_PRINT_MSG];
 	static int  buffOffset = 0;
 	char        *buf;
+	const char  *cached;
+	int         generation = uiInfo.translationGeneration;
 
 	buf = buffer[buffOffset++ % TRANSLATION_BUFFERS];
 
+	// only ask the engine once per string and language
+	if (generation >= 0 && (cached = Translation_Find(string, generation)) != NULL)
+	{
+		Q_strncpyz(buf, cached, MAX_PRINT_MSG);
+		return buf;
+	}
+
 	trap_TranslateString(string, buf);
 
+	if (generation >= 0)
+	{
+		Translation_Add(string, buf, generation);
+	}
+
 	return buf;
 }
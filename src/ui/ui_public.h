@@ -185,6 +185,8 @@ typedef enum
 
 #if !defined(UIDLL) && !defined(CGAMEDLL)
 	UI_TRAP_GETVALUE = COM_TRAP_GETVALUE,
+	UI_CVAR_GET_CHANGES,        ///< trap_Cvar_GetChanges_Legacy
+	UI_TRANSLATION_GENERATION,  ///< trap_TranslationGeneration_Legacy
 #endif
 
 } uiImport_t;
@@ -285,6 +285,127 @@ void String_Report(void)
 	Com_Printf("Memory Pool is %.1f%% full, %i bytes out of %i used.\n", (double)f, allocPoint, MEM_POOL_SIZE);
 }
 
+#define TRANSLATION_HASH_SIZE 2048 // must be a power of two
+#define TRANSLATION_POOL_SIZE (128 * 1024)
+
+/**
+ * @struct translationDef_s
+ * @typedef translationDef_t
+ * @brief Translation cached by the module, both strings live in the translation pool
+ */
+typedef struct translationDef_s
+{
+	const char *msgid;
+	const char *text;
+} translationDef_t;
+
+static translationDef_t translationHash[TRANSLATION_HASH_SIZE];
+static char             translationPool[TRANSLATION_POOL_SIZE];
+static int              translationPoolIndex  = 0;
+static int              translationCount      = 0;
+static int              translationGeneration = -1;
+
+/**
+ * @brief Case sensitive hash of a message id for the translation cache
+ * @param[in] str
+ * @return
+ */
+static unsigned int Translation_Hash(const char *str)
+{
+	unsigned int hash = 2166136261u;
+
+	while (*str)
+	{
+		hash ^= (unsigned char)*str++;
+		hash *= 16777619u;
+	}
+
+	return hash & (TRANSLATION_HASH_SIZE - 1);
+}
+
+/**
+ * @brief Empties the translation cache
+ * @param[in] generation language generation the cache is filled for
+ */
+static void Translation_Clear(int generation)
+{
+	Com_Memset(translationHash, 0, sizeof(translationHash));
+	translationPoolIndex  = 0;
+	translationCount      = 0;
+	translationGeneration = generation;
+}
+
+/**
+ * @brief Looks up a translation cached for the current language
+ * @param[in] msgid original text
+ * @param[in] generation language generation reported by the engine
+ * @return cached translation or NULL if it has to be asked for
+ */
+const char *Translation_Find(const char *msgid, int generation)
+{
+	unsigned int i;
+
+	if (generation != translationGeneration)
+	{
+		Translation_Clear(generation);
+		return NULL;
+	}
+
+	for (i = Translation_Hash(msgid); translationHash[i].msgid; i = (i + 1) & (TRANSLATION_HASH_SIZE - 1))
+	{
+		if (!strcmp(translationHash[i].msgid, msgid))
+		{
+			return translationHash[i].text;
+		}
+	}
+
+	return NULL;
+}
+
+/**
+ * @brief Caches a translation, the cache starts over when it is full
+ * @param[in] msgid original text
+ * @param[in] text translated text
+ * @param[in] generation language generation reported by the engine
+ */
+void Translation_Add(const char *msgid, const char *text, int generation)
+{
+	int          msgidLen = strlen(msgid) + 1;
+	int          textLen  = strlen(text) + 1;
+	unsigned int i;
+
+	if (msgidLen + textLen > TRANSLATION_POOL_SIZE)
+	{
+		return;
+	}
+
+	// keep the table at most half full so probe sequences stay short
+	if (generation != translationGeneration
+	    || translationCount >= TRANSLATION_HASH_SIZE / 2
+	    || translationPoolIndex + msgidLen + textLen > TRANSLATION_POOL_SIZE)
+	{
+		Translation_Clear(generation);
+	}
+
+	for (i = Translation_Hash(msgid); translationHash[i].msgid; i = (i + 1) & (TRANSLATION_HASH_SIZE - 1))
+	{
+		if (!strcmp(translationHash[i].msgid, msgid))
+		{
+			return;
+		}
+	}
+
+	Com_Memcpy(&translationPool[translationPoolIndex], msgid, msgidLen);
+	translationHash[i].msgid = &translationPool[translationPoolIndex];
+	translationPoolIndex    += msgidLen;
+
+	Com_Memcpy(&translationPool[translationPoolIndex], text, textLen);
+	translationHash[i].text = &translationPool[translationPoolIndex];
+	translationPoolIndex   += textLen;
+
+	translationCount++;
+}
+
 /**
  * @brief String_Init
  */
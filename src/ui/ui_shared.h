@@ -683,6 +683,8 @@ void Item_KeyboardActivate(itemDef_t *item);
 const char *String_Alloc(const char *p);
 void String_Init(void);
 void String_Report(void);
+const char *Translation_Find(const char *msgid, int generation);
+void Translation_Add(const char *msgid, const char *text, int generation);
 qboolean IsVisible(int flags);
 void ToWindowCoords(float *x, float *y, windowDef_t *window);
 void Fade(int *flags, float *f, float clamp, int *nextTime, int offsetTime, qboolean bFlags, float fadeAmount);
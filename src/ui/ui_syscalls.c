@@ -1171,3 +1171,82 @@ void trap_GetHunkData(int *hunkused, int *hunkexpected)
 {
 	SystemCall(UI_GETHUNKDATA, hunkused, hunkexpected);
 }
+
+// engine extension traps, looked up by name through trap_GetValue
+static int dll_com_trapGetValue     = 0;
+static int dll_trap_Cvar_GetChanges = 0;
+static int dll_trap_TranslationGen  = 0;
+
+/**
+ * @brief Asks the engine for a value of its extension system
+ * @param[out] value
+ * @param[in] valueSize
+ * @param[in] key
+ * @return qtrue if the engine knows the key
+ */
+static qboolean trap_GetValue(char *value, int valueSize, const char *key)
+{
+	return (qboolean)(SystemCall(dll_com_trapGetValue, value, valueSize, key));
+}
+
+/**
+ * @brief Looks up the engine extension traps used by the module
+ * @note Engines without the extension system leave all of them unset
+ */
+void UI_InitExtensionTraps(void)
+{
+	char value[MAX_CVAR_VALUE_STRING];
+
+	dll_com_trapGetValue     = 0;
+	dll_trap_Cvar_GetChanges = 0;
+	dll_trap_TranslationGen  = 0;
+
+	trap_Cvar_VariableStringBuffer("//trap_GetValue", value, sizeof(value));
+	if (!value[0])
+	{
+		return;
+	}
+
+	dll_com_trapGetValue = Q_atoi(value);
+
+	if (trap_GetValue(value, sizeof(value), "trap_Cvar_GetChanges_Legacy"))
+	{
+		dll_trap_Cvar_GetChanges = Q_atoi(value);
+	}
+
+	if (trap_GetValue(value, sizeof(value), "trap_TranslationGeneration_Legacy"))
+	{
+		dll_trap_TranslationGen = Q_atoi(value);
+	}
+}
+
+/**
+ * @brief Gets the handles of the registered cvars changed since the last call
+ * @param[out] handles
+ * @param[in] maxHandles
+ * @return number of changed cvars, -1 if all cvars have to be updated
+ */
+int trap_Cvar_GetChanges(cvarHandle_t *handles, int maxHandles)
+{
+	if (!dll_trap_Cvar_GetChanges)
+	{
+		return -1;
+	}
+
+	return SystemCall(dll_trap_Cvar_GetChanges, handles, maxHandles);
+}
+
+/**
+ * @brief Gets the language generation of the engine, translations cached
+ * by the module are stale once it changes
+ * @return generation, -1 if the engine can't tell and nothing may be cached
+ */
+int trap_TranslationGeneration(void)
+{
+	if (!dll_trap_TranslationGen)
+	{
+		return -1;
+	}
+
+	return SystemCall(dll_trap_TranslationGen);
+}